@@ -0,0 +1,48 @@
+// $group charges each new group for its hash node, accumulator vector and allocator overhead, not
+// just its _id.  Many small groups therefore reach the memory limit (16945) well before their _ids
+// alone add up to it, and allowDiskUse still lets such a $group spill and finish.
+
+var t = db.group_overhead;
+t.drop();
+
+var sharded = (typeof(RUNNING_IN_SHARDED_AGG_TEST) != 'undefined'); // see end of testshard1.js
+
+// Each document unwinds into this many distinct integer _ids.
+var idsPerDoc = 1500;
+var arr = [];
+for (var i = 0; i < idsPerDoc; i++) {
+    arr.push(i);
+}
+for (var i = 0; i < 1000; i++) {
+    t.insert({_id: i, a: arr});
+}
+assert.eq(null, db.getLastError());
+
+function countGroups(nDocs, allowDiskUse) {
+    var pipeline = [{$match: {_id: {$lt: nDocs}}},
+                    {$unwind: '$a'},
+                    {$group: {_id: {$add: [{$multiply: ['$_id', idsPerDoc]}, '$a']}}},
+                    {$group: {_id: null, n: {$sum: 1}}}];
+    return t.runCommand('aggregate', {pipeline: pipeline, allowDiskUse: allowDiskUse});
+}
+
+if (!sharded) {
+    // 450,000 groups: their _ids alone are about 7MB and with the overhead about 40MB, under the
+    // 100MB limit either way.
+    var res = countGroups(300, false);
+    assert.commandWorked(res);
+    assert.eq(300 * idsPerDoc, res.result[0].n);
+
+    // 1,500,000 groups: their _ids alone are about 24MB, which used to fit, but with the overhead
+    // they are well past the limit.
+    res = countGroups(1000, false);
+    assert.commandFailed(res);
+    assert.eq(16945, res.code);
+
+    // With allowDiskUse the same $group spills and still counts every group.
+    res = countGroups(1000, true);
+    assert.commandWorked(res);
+    assert.eq(1000 * idsPerDoc, res.result[0].n);
+}
+
+t.drop();
@@ -0,0 +1,63 @@
+// SERVER-12015: aggregations whose dependencies are all in one index should be answered from the
+// index without fetching documents, and should produce the same results either way.
+
+var t = db.jstests_aggregation_server12015;
+t.drop();
+
+for (var i = 0; i < 100; i++) {
+    t.insert({_id: i, a: i % 10, b: i % 7, c: "unindexed" + i});
+}
+// Some documents lack 'b' or have it null.  An index holds null for both, so a covered plan
+// would report a missing 'b' as null.
+for (var i = 100; i < 110; i++) {
+    t.insert({_id: i, a: i % 10, c: "unindexed" + i});
+}
+t.insert({_id: 110, a: 4, b: null});
+
+var groupPipeline = [{$match: {a: {$gte: 3}, b: {$gte: 0}}},
+                     {$group: {_id: "$a", total: {$sum: "$b"}}},
+                     {$sort: {_id: 1}}];
+var fetchPipeline = [{$match: {a: {$gte: 3}}},
+                     {$group: {_id: "$a", total: {$sum: "$b"}, any: {$max: "$c"}}},
+                     {$sort: {_id: 1}}];
+// Only 'a' is required by the query, so documents without 'b' reach the $group.  $push and
+// $first tell a missing 'b' from a null one.
+var missingPipeline = [{$match: {a: {$gte: 3}}},
+                       {$sort: {a: 1}},
+                       {$group: {_id: "$a", bs: {$push: "$b"}, first: {$first: "$b"}}},
+                       {$project: {_id: 1, bs: 1, hasFirst: {$ifNull: ["$first", "missing"]}}},
+                       {$sort: {_id: 1}}];
+
+function sortBs(results) {
+    results.forEach(function(r) { if (r.bs) r.bs.sort(); });
+    return results;
+}
+
+// Results without any helpful index, so nothing can be covered.
+var expectedGroup = t.aggregate(groupPipeline).toArray();
+var expectedFetch = t.aggregate(fetchPipeline).toArray();
+var expectedMissing = sortBs(t.aggregate(missingPipeline).toArray());
+
+t.ensureIndex({a: 1, b: 1});
+
+function cursorPlan(pipeline) {
+    var explained = t.runCommand("aggregate", {pipeline: pipeline, explain: true});
+    assert.commandWorked(explained);
+    return explained.stages[0]["$cursor"].plan;
+}
+
+// Every needed field is in {a: 1, b: 1} and required by the query, so the query can be covered.
+assert.eq(true, cursorPlan(groupPipeline).indexOnly, tojson(cursorPlan(groupPipeline)));
+assert.eq(expectedGroup, t.aggregate(groupPipeline).toArray());
+
+// 'c' is not in the index, so documents must be fetched.
+assert.eq(false, cursorPlan(fetchPipeline).indexOnly, tojson(cursorPlan(fetchPipeline)));
+assert.eq(expectedFetch, t.aggregate(fetchPipeline).toArray());
+
+// 'b' may be missing, so documents must be fetched to keep missing and null apart.
+assert.eq(false, cursorPlan(missingPipeline).indexOnly, tojson(cursorPlan(missingPipeline)));
+assert.eq(expectedMissing, sortBs(t.aggregate(missingPipeline).toArray()));
+
+// A multikey index can not cover the query.
+t.insert({_id: 200, a: 5, b: [1, 2]});
+assert.eq(false, cursorPlan(groupPipeline).indexOnly, tojson(cursorPlan(groupPipeline)));
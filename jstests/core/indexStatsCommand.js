@@ -59,6 +59,12 @@ function textWithIndexVersion(version) {
         assert(isObject(data.fillRatio));
         assert.neq(data.fillRatio, null);
         checkStats(data.fillRatio);
+
+        assert(isObject(data.prefixRatio));
+        assert.neq(data.prefixRatio, null);
+        checkStats(data.prefixRatio);
+        assert.gte(data.prefixRatio.min, 0);
+        assert.lte(data.prefixRatio.max, 1);
     }
 
     assert(isObject(result.overall));
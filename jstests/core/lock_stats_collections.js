@@ -0,0 +1,29 @@
+// Tests the per collection breakdown in the locks section of serverStatus
+
+var myDB = db.getSiblingDB("lock_stats_collections");
+myDB.dropDatabase();
+
+myDB.a.insert({x: 1});
+myDB.b.insert({x: 1});
+myDB.b.findOne();
+
+var locks = myDB.serverStatus().locks;
+assert(locks.lock_stats_collections, tojson(locks));
+
+var colls = locks.lock_stats_collections.collections;
+assert(colls, tojson(locks));
+assert(colls["lock_stats_collections.a"], tojson(colls));
+assert(colls["lock_stats_collections.b"], tojson(colls));
+assert(colls["lock_stats_collections.b"].timeLockedMicros, tojson(colls));
+
+// Dropping a collection drops its stats; dropping the database drops them all.
+myDB.a.drop();
+colls = myDB.serverStatus().locks.lock_stats_collections.collections;
+assert(!colls["lock_stats_collections.a"], tojson(colls));
+assert(colls["lock_stats_collections.b"], tojson(colls));
+
+myDB.dropDatabase();
+locks = myDB.serverStatus().locks;
+if (locks.lock_stats_collections) {
+    assert.eq({}, locks.lock_stats_collections.collections, tojson(locks));
+}
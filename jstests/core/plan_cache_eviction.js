@@ -0,0 +1,39 @@
+// A cached plan that takes more than internalQueryCacheEvictionRatio times the works it took in
+// the trial run that cached it is evicted, so the next query of its shape is planned again.  A
+// run that stays below the ratio leaves the entry in place.
+
+var t = db.jstests_plan_cache_eviction;
+t.drop();
+
+// Index {a: 1} is best for a: 1 and a: 3, but has to scan every a: 2 document.
+t.save({a: 1, b: 1});
+for (var i = 0; i < 5000; i++) {
+    t.save({a: 2, b: 1});
+}
+t.save({a: 3, b: 3});
+assert.eq(null, db.getLastError());
+
+t.ensureIndex({a: 1});
+t.ensureIndex({b: 1});
+
+function cachedPlans() {
+    return t.getPlanCache().getPlansByQuery({a: 1, b: 1});
+}
+
+// Caches index {a: 1}, after a trial run of only a few works.
+assert.eq(1, t.find({a: 1, b: 1}).itcount());
+assert.gt(cachedPlans().length, 0, tojson(cachedPlans()));
+
+// The cached plan does about as much work as in its trial run; the entry stays.
+assert.eq(1, t.find({a: 3, b: 3}).itcount());
+assert.gt(cachedPlans().length, 0, tojson(cachedPlans()));
+
+// The cached plan scans 5000 keys and documents to find nothing; the entry goes.
+assert.eq(0, t.find({a: 2, b: 2}).itcount());
+assert.eq(0, cachedPlans().length, tojson(cachedPlans()));
+
+// The next query of the shape is planned and cached again.
+assert.eq(1, t.find({a: 1, b: 1}).itcount());
+assert.gt(cachedPlans().length, 0, tojson(cachedPlans()));
+
+t.drop();
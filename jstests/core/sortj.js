@@ -1,17 +1,26 @@
 // Test an in memory sort memory assertion after a plan has "taken over" in the query optimizer
 // cursor.
 
-t = db.jstests_sortj;
-t.drop();
+// Blocking sorts spill to disk by default; turn that off to exercise the memory limit.
+assert.commandWorked( db._adminCommand( { setParameter:1,
+                                          internalQueryExecAllowExternalSort:false } ) );
 
-t.ensureIndex( { a:1 } );
+try {
+    t = db.jstests_sortj;
+    t.drop();
 
-big = new Array( 100000 ).toString();
-for( i = 0; i < 1000; ++i ) {
-    t.save( { a:1, b:big } );
-}
+    t.ensureIndex( { a:1 } );
+
+    big = new Array( 100000 ).toString();
+    for( i = 0; i < 1000; ++i ) {
+        t.save( { a:1, b:big } );
+    }
 
-assert.throws( function() {
-              t.find( { a:{ $gte:0 }, c:null } ).sort( { d:1 } ).itcount();
-              } );
-t.drop();
\ No newline at end of file
+    assert.throws( function() {
+                  t.find( { a:{ $gte:0 }, c:null } ).sort( { d:1 } ).itcount();
+                  } );
+    t.drop();
+}
+finally {
+    db._adminCommand( { setParameter:1, internalQueryExecAllowExternalSort:true } );
+}
@@ -14,6 +14,18 @@ assert.gt( stats.fileSize, 0 );
 assert.eq( stats.dataFileVersion.major, 4 );
 assert.eq( stats.dataFileVersion.minor, 5 );
 
+// verbose collStats summarizes the deleted record lists
+for ( var i = 0; i < 100; i++ ) {
+    t.save( { a : i, s : new Array( 200 ).join( "x" ) } );
+}
+t.remove( { a : { $lt : 50 } } );
+var collStats = statsDB.runCommand( { collStats : "stats1", verbose : true } );
+assert( collStats.extents instanceof Array, "D" );
+assert.lt( 0, collStats.freeList.count, "E" );
+assert.lte( collStats.freeList.largest, collStats.freeList.size, "F" );
+assert.eq( 19, collStats.freeList.perBucket.length, "G" );
+assert.eq( undefined, t.stats().freeList, "H" );
+
 // test empty database; should be no dataFileVersion
 statsDB.dropDatabase();
 var statsEmptyDB = statsDB.stats();
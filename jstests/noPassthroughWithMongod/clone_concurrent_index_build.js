@@ -0,0 +1,60 @@
+// copydb and cloneCollection only lock the database they write to.  Check that they copy
+// everything, with its _id index, while a unique index build on another database keeps
+// failing on duplicates instead of dropping them.
+
+var baseName = "jstests_clone_concurrent_index_build";
+
+var fromMongod = MongoRunner.runMongod({});
+var toMongod = MongoRunner.runMongod({});
+var fromHost = "localhost:" + fromMongod.port;
+
+var f = fromMongod.getDB(baseName);
+var nDocs = 20 * 1000;
+for (var i = 0; i < nDocs; i++) {
+    f.big.insert({_id: i, x: i, pad: new Array(100).join("x")});
+}
+assert.eq(null, f.getLastError());
+
+// Another database on the destination, with duplicates a unique index must refuse.
+var other = toMongod.getDB(baseName + "_other");
+for (var i = 0; i < 100; i++) {
+    other.dups.insert({x: i % 10});
+}
+assert.eq(null, other.getLastError());
+
+var copier = startParallelShell(
+    "var fromHost = '" + fromHost + "';" +
+    "for (var i = 0; i < 5; i++) {" +
+    "    var copy = db.getSiblingDB('" + baseName + "_copy');" +
+    "    copy.dropDatabase();" +
+    "    assert.commandWorked(db.adminCommand({copydb: 1, fromhost: fromHost," +
+    "                                          fromdb: '" + baseName + "'," +
+    "                                          todb: copy.getName()}));" +
+    "    var cloned = db.getSiblingDB('" + baseName + "');" +
+    "    cloned.big.drop();" +
+    "    assert.commandWorked(cloned.runCommand({cloneCollection: '" + baseName + ".big'," +
+    "                                             from: fromHost}));" +
+    "}" +
+    "db.getSiblingDB('" + baseName + "_other').done.insert({});",
+    toMongod.port);
+
+do {
+    other.dups.ensureIndex({x: 1}, {unique: true});
+    var err = other.getLastErrorObj();
+    assert.eq(11000, err.code, tojson(err));
+    assert.eq(100, other.dups.count());
+} while (other.done.count() == 0);
+copier();
+
+function checkCopy(coll) {
+    assert.eq(nDocs, coll.count());
+    assert.eq(nDocs, coll.find().hint({_id: 1}).itcount());
+    var validate = coll.validate(true);
+    assert(validate.valid, tojson(validate));
+}
+checkCopy(toMongod.getDB(baseName + "_copy").big);
+checkCopy(toMongod.getDB(baseName).big);
+assert.eq(1, other.dups.getIndexes().length);
+
+MongoRunner.stopMongod(fromMongod.port);
+MongoRunner.stopMongod(toMongod.port);
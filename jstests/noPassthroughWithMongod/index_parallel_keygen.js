@@ -0,0 +1,37 @@
+// Foreground builds of plain btree indexes generate keys on several threads.  Check that the
+// resulting index holds every key, and that a key generation error still fails the build.
+
+var t = db.index_parallel_keygen;
+t.drop();
+
+var nDocs = 20 * 1000;
+for (var i = 0; i < nDocs; i++) {
+    // Every tenth document is multikey.
+    t.insert({_id: i, a: (i % 10 == 0) ? [i, -i] : i, b: i % 7});
+}
+assert.eq(null, db.getLastError());
+
+assert.commandWorked(db.adminCommand({setParameter: 1, indexBuildKeyGenerationThreads: 4}));
+
+t.ensureIndex({a: 1, b: 1});
+assert.eq(null, db.getLastError());
+
+var validate = t.validate(true);
+assert(validate.valid, tojson(validate));
+assert.eq(nDocs + nDocs / 10 - 1, validate.keysPerIndex[t.getFullName() + ".$a_1_b_1"],
+          tojson(validate));
+
+assert.eq(nDocs / 10 - 1, t.find({a: {$lt: 0}}).hint({a: 1, b: 1}).itcount());
+assert.eq(nDocs, t.find().hint({a: 1, b: 1}).itcount());
+
+// Parallel arrays can't be indexed; the error has to surface from the worker threads.
+assert.commandWorked(t.dropIndex({a: 1, b: 1}));
+t.insert({_id: nDocs, a: [1, 2], b: [1, 2]});
+assert.eq(null, db.getLastError());
+t.ensureIndex({b: 1, a: 1});
+var err = db.getLastErrorObj();
+assert.eq(10088, err.code, tojson(err));
+assert.eq(1, t.getIndexes().length);
+
+t.drop();
+assert.commandWorked(db.adminCommand({setParameter: 1, indexBuildKeyGenerationThreads: 1}));
@@ -1,4 +1,3 @@
-
 t = db.parallel_collection_scan;
 t.drop();
 
@@ -10,15 +9,28 @@ for ( i = 0; i < 8000; i++ ) {
     t.insert( { x : i, s : s } );
  }
 
+// about 80MB in extents that grow geometrically, the last one only partly filled
+assert.lte( 5, t.stats().numExtents, tojson( t.stats() ) );
 
 function iterateSliced() {
     var res = t.runCommand( "parallelCollectionScan", { numCursors : 3 } );
     assert( res.ok, tojson( res ) );
     var count = 0;
+    var counts = [];
     for ( var i = 0; i < res.cursors.length; i++ ) {
         var x = res.cursors[i];
         var cursor = new DBCommandCursor( db.getMongo(), x, 5 );
-        count += cursor.itcount();
+        var cursorCount = cursor.itcount();
+        counts.push( cursorCount );
+        count += cursorCount;
+    }
+
+    // extents are dealt out by the data in them, so every cursor gets a similar share
+    assert.eq( 3, counts.length, tojson( res ) );
+    var mean = count / counts.length;
+    for ( var i = 0; i < counts.length; i++ ) {
+        assert.lte( mean * 0.67, counts[i], tojson( counts ) );
+        assert.gte( mean * 1.33, counts[i], tojson( counts ) );
     }
 
     return count;
@@ -0,0 +1,48 @@
+// Secondaries apply a large batch in several rounds, letting reads in between them.  Check that
+// a batch held back until it is large is split into rounds and still applied in oplog order.
+
+var rt = new ReplSetTest({name: 'apply_batch_rounds', nodes: 2});
+rt.startSet();
+rt.initiate();
+rt.awaitSecondaryNodes();
+
+var primary = rt.getPrimary();
+var secondary = rt.getSecondary();
+var testDB = primary.getDB('test');
+var sAdmin = secondary.getDB('admin');
+
+assert.writeOK(testDB.coll.insert({_id: 'counter', n: 0}, {writeConcern: {w: 2}}));
+assert.commandWorked(sAdmin.runCommand({setParameter: 1, replBatchApplyRoundOps: 10}));
+
+function applyMetrics() {
+    return secondary.getDB('test').serverStatus().metrics.repl.apply;
+}
+
+// Hold application so the ops below pile up into a batch of their own.
+assert.commandWorked(sAdmin.runCommand({configureFailPoint: 'rsSyncApplyStop', mode: 'alwaysOn'}));
+var before = applyMetrics();
+
+for (var i = 0; i < 500; i++) {
+    testDB.coll.insert({_id: i});
+    testDB.coll.update({_id: 'counter'}, {$inc: {n: 1}});
+}
+assert.eq(null, testDB.getLastError());
+
+assert.soon(function() {
+    return secondary.getDB('test').serverStatus().metrics.repl.buffer.count >= 900;
+});
+assert.commandWorked(sAdmin.runCommand({configureFailPoint: 'rsSyncApplyStop', mode: 'off'}));
+rt.awaitReplication();
+
+// 1000 ops in rounds of at most 10, bar the few taken into a batch before the pause.  Batches
+// are still counted once each, however many rounds they take.
+var after = applyMetrics();
+assert.gte(after.rounds - before.rounds, 80, tojson(after));
+assert.lt(after.batches.num - before.batches.num, after.rounds - before.rounds, tojson(after));
+
+secondary.setSlaveOk();
+var sColl = secondary.getDB('test').coll;
+assert.eq(501, sColl.count());
+assert.eq(500, sColl.findOne({_id: 'counter'}).n);
+
+rt.stopSet();
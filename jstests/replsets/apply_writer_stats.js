@@ -0,0 +1,58 @@
+// replSetGetStatus reports per writer oplog apply counters on data bearing members.  Check their
+// shape, that they add up to the ops applied, and that ops for one namespace go to one writer.
+
+var rt = new ReplSetTest({name: 'apply_writer_stats', nodes: 3});
+var nodes = rt.nodeList();
+rt.startSet();
+rt.initiate({_id: 'apply_writer_stats',
+             members: [{_id: 0, host: nodes[0]},
+                       {_id: 1, host: nodes[1]},
+                       {_id: 2, host: nodes[2], arbiterOnly: true}]});
+rt.awaitSecondaryNodes();
+
+var primary = rt.getPrimary();
+var secondary = rt.getSecondary();
+var arbiter = rt.nodes[2];
+
+function writerStats() {
+    var status = secondary.getDB('admin').runCommand({replSetGetStatus: 1});
+    assert.commandWorked(status);
+    assert(status.applyWriters, tojson(status));
+    status.applyWriters.forEach(function(w) {
+        assert.gte(w.batches, 0, tojson(w));
+        assert.gte(w.ops, 0, tojson(w));
+        assert.gte(w.applyMicros, 0, tojson(w));
+    });
+    return status.applyWriters;
+}
+
+var status = arbiter.getDB('admin').runCommand({replSetGetStatus: 1});
+assert.commandWorked(status);
+assert(!status.applyWriters, tojson(status));
+
+var before = writerStats();
+assert.gt(before.length, 0);
+
+var bulk = primary.getDB('test').coll.initializeUnorderedBulkOp();
+for (var i = 0; i < 1000; i++) {
+    bulk.insert({_id: i});
+}
+assert.writeOK(bulk.execute({w: 2}));
+
+var after = writerStats();
+assert.eq(before.length, after.length);
+
+var grown = [];
+var totalOps = 0;
+for (var i = 0; i < after.length; i++) {
+    assert.gte(after[i].ops, before[i].ops);
+    if (after[i].ops > before[i].ops) {
+        grown.push(i);
+        totalOps += after[i].ops - before[i].ops;
+    }
+}
+// the inserts plus any no-op or heartbeat writes that were applied meanwhile
+assert.gte(totalOps, 1000, tojson(after));
+assert.lte(grown.length, 2, tojson(after));
+
+rt.stopSet();
@@ -0,0 +1,38 @@
+// Initial sync clones several databases at once.  Make sure every database, with its documents
+// and indexes, still ends up on the new member.
+
+var rs = new ReplSetTest({name: 'initial_sync_parallel_clone', nodes: 1, host: 'localhost'});
+rs.startSet();
+rs.initiate();
+var primary = rs.getMaster();
+
+var nDbs = 6;
+var nDocs = 2000;
+for (var d = 0; d < nDbs; d++) {
+    var pdb = primary.getDB('parallel_clone' + d);
+    for (var i = 0; i < nDocs; i++) {
+        pdb.coll.insert({_id: i, x: i % 100, db: d});
+        pdb.other.insert({_id: i});
+    }
+    pdb.coll.ensureIndex({x: 1});
+    assert.eq(null, pdb.getLastError());
+}
+
+var secondary = rs.add({setParameter: 'initialSyncCloneThreads=3'});
+rs.reInitiate(60000);
+rs.awaitSecondaryNodes();
+rs.awaitReplication();
+
+secondary.setSlaveOk();
+for (var d = 0; d < nDbs; d++) {
+    var sdb = secondary.getDB('parallel_clone' + d);
+    assert.eq(nDocs, sdb.coll.count(), 'coll in db ' + d);
+    assert.eq(nDocs, sdb.other.count(), 'other in db ' + d);
+    assert.eq(2, sdb.coll.getIndexes().length, 'indexes in db ' + d);
+    assert.eq(nDocs / 100, sdb.coll.find({x: 7}).hint({x: 1}).itcount(), 'index in db ' + d);
+}
+
+// The clone progress is only reported while syncing.
+assert(!secondary.getDB('admin').runCommand({replSetGetStatus: 1}).initialSyncStatus);
+
+rs.stopSet(15);
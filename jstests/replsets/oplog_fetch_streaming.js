@@ -0,0 +1,68 @@
+// Secondaries stream the oplog from their sync source over an exhaust cursor and prefetch ops
+// as they arrive.  Check that replication keeps up with streaming and prefetching on, and
+// after they are switched off, and that prefetching never brings back a dropped database.
+
+var rt = new ReplSetTest({name: 'oplog_fetch_streaming', nodes: 2, oplogSize: 100});
+rt.startSet();
+rt.initiate();
+rt.awaitSecondaryNodes();
+
+var primary = rt.getPrimary();
+var secondary = rt.getSecondary();
+var testDB = primary.getDB('test');
+testDB.coll.ensureIndex({x: 1});
+
+function writeAndCheck(nDocs) {
+    var bulk = testDB.coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < nDocs; i++) {
+        bulk.insert({x: i});
+    }
+    assert.writeOK(bulk.execute({w: 2}));
+    assert.writeOK(testDB.coll.update({}, {$inc: {x: 1}}, {multi: true, writeConcern: {w: 2}}));
+
+    secondary.setSlaveOk();
+    var sColl = secondary.getDB('test').coll;
+    assert.eq(testDB.coll.count(), sColl.count());
+    assert.eq(testDB.coll.find({x: 1}).count(), sColl.find({x: 1}).hint({x: 1}).count());
+}
+
+function metrics() {
+    return secondary.getDB('test').serverStatus().metrics.repl;
+}
+
+writeAndCheck(1000);
+assert.gt(metrics().preload.onFetch, 0, tojson(metrics().preload));
+assert.gt(metrics().network.streamedBatches, 0, tojson(metrics().network));
+
+// Prefetches queued for a database's inserts may still be pending when the drop after them is
+// applied; they must not open the database again.
+for (var i = 0; i < 20; i++) {
+    var dropDB = primary.getDB('oplog_fetch_streaming_drop');
+    var bulk = dropDB.coll.initializeUnorderedBulkOp();
+    for (var j = 0; j < 100; j++) {
+        bulk.insert({x: j});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(dropDB.dropDatabase());
+}
+rt.awaitReplication();
+sleep(1000);
+assert.eq(-1, secondary.getDBNames().indexOf('oplog_fetch_streaming_drop'),
+          tojson(secondary.getDBNames()));
+
+var admin = secondary.getDB('admin');
+assert.commandWorked(admin.runCommand({setParameter: 1, replOplogFetchStreaming: false}));
+assert.commandWorked(admin.runCommand({setParameter: 1, replPrefetchOnFetch: false}));
+
+// Make the secondary pick its sync source again so the new settings take effect.  The write
+// after it may still arrive over the old cursor; whatever follows comes over the new one.
+assert.commandWorked(admin.runCommand({replSetSyncFrom: rt.getPrimary().host}));
+assert.writeOK(testDB.coll.insert({x: -1}, {writeConcern: {w: 2}}));
+var onFetch = metrics().preload.onFetch;
+var streamedBatches = metrics().network.streamedBatches;
+
+writeAndCheck(1000);
+assert.eq(onFetch, metrics().preload.onFetch);
+assert.eq(streamedBatches, metrics().network.streamedBatches);
+
+rt.stopSet();
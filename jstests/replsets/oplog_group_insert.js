@@ -0,0 +1,73 @@
+// Batched inserts on a primary write their oplog entries in groups.  Check that every insert
+// that succeeded is logged exactly once and in order, including around errors in the batch,
+// and that the secondary ends up with the same documents.
+
+var rt = new ReplSetTest({name: 'oplog_group_insert', nodes: 2});
+rt.startSet();
+rt.initiate();
+rt.awaitSecondaryNodes();
+
+var primary = rt.getPrimary();
+var secondary = rt.getSecondary();
+var testDB = primary.getDB('test');
+var oplog = primary.getDB('local').oplog.rs;
+
+function checkOplog(coll, ids) {
+    var entries = oplog.find({op: 'i', ns: coll.getFullName()}).sort({$natural: 1}).toArray();
+    assert.eq(ids.length, entries.length);
+    for (var i = 0; i < ids.length; i++) {
+        assert.eq(ids[i], entries[i].o._id, tojson(entries[i]));
+        if (i > 0) {
+            assert.lt(0, bsonWoCompare({ts: entries[i].ts}, {ts: entries[i - 1].ts}));
+        }
+    }
+
+    secondary.setSlaveOk();
+    var sColl = secondary.getDB('test')[coll.getName()];
+    assert.eq(ids.length, sColl.count());
+    assert.eq(ids, sColl.find({}, {_id: 1}).sort({_id: 1}).toArray().map(function(d) {
+        return d._id;
+    }));
+}
+
+function runBatches(coll) {
+    var ids = [];
+    var bulk = coll.initializeOrderedBulkOp();
+    for (var i = 0; i < 1000; i++) {
+        bulk.insert({_id: i});
+        ids.push(i);
+    }
+    assert.writeOK(bulk.execute({w: 2}));
+
+    // An ordered batch stops at its first error; everything before it is still logged.
+    bulk = coll.initializeOrderedBulkOp();
+    for (var i = 1000; i < 1300; i++) {
+        bulk.insert({_id: i});
+        ids.push(i);
+    }
+    bulk.insert({_id: 5});
+    bulk.insert({_id: 2000});
+    assert.throws(function() { bulk.execute({w: 2}); });
+
+    // An unordered batch carries on past its errors.
+    bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 3000; i < 3500; i++) {
+        bulk.insert({_id: i});
+        if (i % 100 == 0) {
+            bulk.insert({_id: i - 3000});
+        }
+        ids.push(i);
+    }
+    assert.throws(function() { bulk.execute({w: 2}); });
+    rt.awaitReplication();
+
+    checkOplog(coll, ids);
+}
+
+runBatches(testDB.grouped);
+
+assert.commandWorked(primary.getDB('admin').runCommand({setParameter: 1,
+                                                         oplogGroupInsertMaxOps: 1}));
+runBatches(testDB.single);
+
+rt.stopSet();
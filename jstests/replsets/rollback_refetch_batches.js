@@ -0,0 +1,96 @@
+// Rollback refetches the documents it has to undo in $in batches over several connections.
+// Roll back enough inserts, updates and removes, with mixed _id types, to span many small
+// batches, and check the rolled back member ends up matching the primary.
+
+load("jstests/replsets/rslib.js");
+
+var replTest = new ReplSetTest({name: 'rollback_refetch_batches', nodes: 3});
+var nodes = replTest.nodeList();
+var conns = replTest.startSet();
+replTest.initiate({_id: 'rollback_refetch_batches',
+                   members: [{_id: 0, host: nodes[0]},
+                             {_id: 1, host: nodes[1]},
+                             {_id: 2, host: nodes[2], arbiterOnly: true}]});
+
+var master = replTest.getMaster();
+assert(master == conns[0], "conns[0] assumed to be master");
+var a_conn = conns[0];
+var b_conn = conns[1];
+a_conn.setSlaveOk();
+b_conn.setSlaveOk();
+var A = a_conn.getDB("admin");
+var B = b_conn.getDB("admin");
+var a = a_conn.getDB("foo");
+var b = b_conn.getDB("foo");
+
+assert.commandWorked(B.runCommand({setParameter: 1, rollbackRefetchBatchSize: 7}));
+assert.commandWorked(B.runCommand({setParameter: 1, rollbackRefetchThreads: 3}));
+
+function idFor(i) {
+    switch (i % 3) {
+    case 0: return i;
+    case 1: return 'str' + i;
+    default: return {sub: i};
+    }
+}
+
+for (var i = 0; i < 300; i++) {
+    a.coll.insert({_id: idFor(i), x: i});
+    a.other.insert({_id: i});
+}
+assert.eq(null, a.getLastError());
+replTest.awaitReplication();
+
+function reconnect() {
+    assert.soon(function() {
+        try {
+            a.coll.stats();
+            b.coll.stats();
+            return true;
+        }
+        catch (e) {
+            return false;
+        }
+    });
+}
+
+// Make B primary while A can't see it, and write there.
+A.runCommand({replSetTest: 1, blind: true});
+reconnect();
+assert.soon(function() { try { return B.isMaster().ismaster; } catch (e) { return false; } });
+
+for (var i = 300; i < 400; i++) {
+    b.coll.insert({_id: idFor(i), x: i});
+}
+for (var i = 0; i < 300; i += 3) {
+    b.coll.update({_id: idFor(i)}, {$set: {rolledBack: true}});
+}
+for (var i = 1; i < 300; i += 6) {
+    b.coll.remove({_id: idFor(i)});
+}
+b.other.remove({_id: {$lt: 50}});
+assert.eq(null, b.getLastError());
+
+// Switch back to A as primary, then bring B back so it has to roll back.
+B.runCommand({replSetTest: 1, blind: true});
+reconnect();
+A.runCommand({replSetTest: 1, blind: false});
+reconnect();
+assert.soon(function() { try { return !B.isMaster().ismaster; } catch (e) { return false; } });
+assert.soon(function() { try { return A.isMaster().ismaster; } catch (e) { return false; } });
+
+a.coll.insert({_id: 'kept', x: -1});
+assert.eq(null, a.getLastError());
+
+B.runCommand({replSetTest: 1, blind: false});
+reconnect();
+
+assert.soon(function() { return B.isMaster().secondary; });
+replTest.awaitReplication();
+
+assert.eq(301, b.coll.count());
+assert.eq(0, b.coll.count({rolledBack: true}));
+assert.eq(300, b.other.count());
+assert.eq(a.coll.find().sort({_id: 1}).toArray(), b.coll.find().sort({_id: 1}).toArray());
+
+replTest.stopSet(15);
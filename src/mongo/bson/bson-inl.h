@@ -266,7 +266,9 @@ dodouble:
         BSONObjIterator i(*this);
         while ( i.more() ) {
             BSONElement e = i.next();
-            if ( name == e.fieldName() )
+            // next() has already measured the field name, so compare against the cached size
+            // rather than strlen()ing the name a second time.
+            if ( name == e.fieldNameStringData() )
                 return e;
         }
         return BSONElement();
@@ -235,7 +235,12 @@ namespace mongo {
         if ( cursorId == 0 )
             return false;
 
-        requestMore();
+        // with QueryOption_Exhaust the server is already sending the next batch; asking for it
+        // would put a getMore reply out of order on the connection.
+        if ( opts & QueryOption_Exhaust )
+            exhaustReceiveMore();
+        else
+            requestMore();
         return batch.pos < batch.nReturned;
     }
 
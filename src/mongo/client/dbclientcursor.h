@@ -47,7 +47,8 @@ namespace mongo {
     /** Queries return a cursor object */
     class MONGO_CLIENT_API DBClientCursor : public DBClientCursorInterface {
     public:
-        /** If true, safe to call next().  Requests more from server if necessary. */
+        /** If true, safe to call next().  Requests more from server if necessary, or for an
+            exhaust cursor waits for the next batch the server sends on its own. */
         bool more();
 
         /** If true, there is more in our local buffers to be fetched via next(). Returns
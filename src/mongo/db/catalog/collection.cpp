@@ -168,6 +168,8 @@ namespace mongo {
         if ( !loc.isOK() )
             return loc;
 
+        _noteWrite( loc.getValue() );
+
         return StatusWith<DiskLoc>( loc );
     }
 
@@ -204,6 +206,8 @@ namespace mongo {
         if ( !loc.isOK() )
             return loc;
 
+        _noteWrite( loc.getValue() );
+
         InsertDeleteOptions indexOptions;
         indexOptions.logIfError = false;
         indexOptions.dupsAllowed = true; // in repair we should be doing no checking
@@ -230,6 +234,7 @@ namespace mongo {
             return loc;
 
         _infoCache.notifyOfWriteOp();
+        _noteWrite( loc.getValue() );
 
         try {
             _indexCatalog.indexRecord( docToInsert, loc.getValue() );
@@ -391,10 +396,28 @@ namespace mongo {
         //  update in place
         int sz = objNew.objsize();
         memcpy(getDur().writingPtr(oldRecord->data(), sz), objNew.objdata(), sz);
+        _noteWrite( oldLocation );
 
         return StatusWith<DiskLoc>( oldLocation );
     }
 
+    void Collection::notifyOfInPlaceUpdate( const DiskLoc& loc ) {
+        _noteWrite( loc );
+    }
+
+    void Collection::_noteWrite( const DiskLoc& loc ) {
+        // collection scans never use synopses on capped collections
+        if ( _details->isCapped() )
+            return;
+
+        ExtentSynopses* synopses = _infoCache.getExtentSynopses();
+        if ( !synopses->noteWriteNeedsDoc() )
+            return;
+
+        Record* rec = _recordStore->recordFor( loc );
+        synopses->noteWrite( rec->myExtentLoc( loc ), BSONObj( rec->data() ) );
+    }
+
     int64_t Collection::storageSize( int* numExtents, BSONArrayBuilder* extentInfo ) const {
         if ( _details->firstExtent().isNull() ) {
             if ( numExtents )
@@ -433,6 +456,10 @@ namespace mongo {
         return &_database->getExtentManager();
     }
 
+    Extent* Collection::getExtent( const DiskLoc& loc ) const {
+        return getExtentManager()->getExtent( loc );
+    }
+
     void Collection::increaseStorageSize( int size, bool enforceQuota ) {
         _recordStore->increaseStorageSize( size, enforceQuota ? largestFileNumberInQuota() : 0 );
     }
@@ -45,6 +45,7 @@
 namespace mongo {
 
     class Database;
+    class Extent;
     class ExtentManager;
     class NamespaceDetails;
     class IndexCatalog;
@@ -150,6 +151,12 @@ namespace mongo {
          */
         std::vector<RecordIterator*> getManyIterators() const;
 
+        /**
+         * @return the extent at 'loc', for scans that walk the extent list themselves, e.g. to
+         * skip extents whose synopses rule out a match.
+         */
+        Extent* getExtent( const DiskLoc& loc ) const;
+
 
         /**
          * does a table scan to do a count
@@ -184,6 +191,12 @@ namespace mongo {
                                             bool enforceQuota,
                                             OpDebug* debug );
 
+        /**
+         * must be called after the document at 'loc' is changed in place without going through
+         * updateDocument, so that state derived from document contents stays correct
+         */
+        void notifyOfInPlaceUpdate( const DiskLoc& loc );
+
         int64_t storageSize( int* numExtents = NULL, BSONArrayBuilder* extentInfo = NULL ) const;
 
         // -----------
@@ -251,6 +264,11 @@ namespace mongo {
         StatusWith<DiskLoc> _insertDocument( const BSONObj& doc,
                                              bool enforceQuota );
 
+        /**
+         * tells the extent synopses about the document just written at 'loc'
+         */
+        void _noteWrite( const DiskLoc& loc );
+
         void _compactExtent(const DiskLoc diskloc, int extentNumber,
                             MultiIndexBlock& indexesToInsertTo,
                             const CompactOptions* compactOptions, CompactStats* stats );
@@ -43,12 +43,14 @@ namespace mongo {
         : _collection( collection ),
           _keysComputed( false ),
           _planCache(new PlanCache(collection->ns().ns())),
-          _querySettings(new QuerySettings()) { }
+          _querySettings(new QuerySettings()),
+          _extentSynopses(new ExtentSynopses()) { }
 
     void CollectionInfoCache::reset() {
         Lock::assertWriteLocked( _collection->ns().ns() );
         LOG(1) << _collection->ns().ns() << ": clearing plan cache - collection info cache reset";
         clearQueryCache();
+        _extentSynopses->clear();
         _keysComputed = false;
         // query settings is not affected by info cache reset.
         // index filters should persist throughout life of collection
@@ -93,4 +95,8 @@ namespace mongo {
         return _querySettings.get();
     }
 
+    ExtentSynopses* CollectionInfoCache::getExtentSynopses() const {
+        return _extentSynopses.get();
+    }
+
 }
@@ -32,6 +32,7 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include "mongo/db/catalog/extent_synopses.h"
 #include "mongo/db/index_set.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/query/plan_cache.h"
@@ -68,6 +69,11 @@ namespace mongo {
          */
         QuerySettings* getQuerySettings() const;
 
+        /**
+         * Get the per-extent value summaries collection scans use to skip extents.
+         */
+        ExtentSynopses* getExtentSynopses() const;
+
         // -------------------
 
         /* get set of index keys for this namespace.  handy to quickly check if a given
@@ -106,6 +112,9 @@ namespace mongo {
         // Includes index filters.
         boost::scoped_ptr<QuerySettings> _querySettings;
 
+        // Min/max summaries of extents built up by collection scans.
+        boost::scoped_ptr<ExtentSynopses> _extentSynopses;
+
         void computeIndexKeys();
     };
 
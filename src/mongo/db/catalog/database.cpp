@@ -416,6 +416,7 @@ namespace mongo {
         LOG(1) << "\t dropIndexes done" << endl;
 
         Top::global.collectionDropped( fullns );
+        Lock::dropCollectionStats( fullns );
 
         Status s = _dropNS( fullns );
 
@@ -555,6 +556,7 @@ namespace mongo {
         }
 
         Top::global.collectionDropped( fromNS.toString() );
+        Lock::dropCollectionStats( fromNS );
 
         return Status::OK();
     }
@@ -0,0 +1,244 @@
+// extent_synopses.cpp
+
+/**
+*    Copyright (C) 2014 MongoDB Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#include "mongo/db/catalog/extent_synopses.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo {
+
+    namespace {
+
+        bool isComparison(const MatchExpression* expr) {
+            switch (expr->matchType()) {
+            case MatchExpression::EQ:
+            case MatchExpression::LT:
+            case MatchExpression::LTE:
+            case MatchExpression::GT:
+            case MatchExpression::GTE:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * Returns true if the comparison 'expr' can't be true for any value in 'range'.
+         */
+        bool rangeExcludes(const ExtentSynopses::FieldRange& range,
+                           const ComparisonMatchExpression* expr) {
+            if (!range.usable || range.min.isEmpty())
+                return false;
+
+            const BSONElement& rhs = expr->getData();
+            switch (rhs.type()) {
+            case Array:
+            case RegEx:
+            case jstNULL:
+            case Undefined:
+            case MinKey:
+            case MaxKey:
+                // These match more than their canonical position in the sort order suggests.
+                return false;
+            default:
+                break;
+            }
+
+            const int cmpMin = rhs.woCompare(range.min.firstElement(), false);
+            const int cmpMax = rhs.woCompare(range.max.firstElement(), false);
+
+            switch (expr->matchType()) {
+            case MatchExpression::EQ: return cmpMin < 0 || cmpMax > 0;
+            case MatchExpression::LT: return cmpMin <= 0;
+            case MatchExpression::LTE: return cmpMin < 0;
+            case MatchExpression::GT: return cmpMax >= 0;
+            case MatchExpression::GTE: return cmpMax > 0;
+            default: return false;
+            }
+        }
+
+        bool rangesExclude(const ExtentSynopses::FieldRanges& ranges,
+                           const MatchExpression* expr) {
+            if (MatchExpression::AND == expr->matchType()) {
+                for (size_t i = 0; i < expr->numChildren(); ++i) {
+                    if (rangesExclude(ranges, expr->getChild(i)))
+                        return true;
+                }
+                return false;
+            }
+
+            if (!isComparison(expr))
+                return false;
+
+            const ComparisonMatchExpression* cmp =
+                static_cast<const ComparisonMatchExpression*>(expr);
+            ExtentSynopses::FieldRanges::const_iterator it = ranges.find(cmp->path().toString());
+            if (it == ranges.end())
+                return false;
+
+            return rangeExcludes(it->second, cmp);
+        }
+
+        void addField(const MatchExpression* expr, std::vector<std::string>* fields) {
+            if (!isComparison(expr))
+                return;
+
+            const std::string path = static_cast<const ComparisonMatchExpression*>(expr)
+                                         ->path().toString();
+            if (path.find('.') != std::string::npos)
+                return;
+
+            if (std::find(fields->begin(), fields->end(), path) != fields->end())
+                return;
+
+            if (fields->size() < ExtentSynopses::kMaxFields)
+                fields->push_back(path);
+        }
+
+    }  // namespace
+
+    void ExtentSynopses::FieldRange::add(const BSONElement& e) {
+        if (!usable)
+            return;
+
+        if (Array == e.type() || e.size() > kMaxValueSize) {
+            usable = false;
+            min = BSONObj();
+            max = BSONObj();
+            return;
+        }
+
+        static const BSONObj nullObj = BSON("" << BSONNULL);
+        const BSONElement value = e.eoo() ? nullObj.firstElement() : e;
+
+        // This runs for every record a scan reads, so only copy values that widen the range.
+        if (min.isEmpty()) {
+            min = value.wrap("");
+            max = min;
+        }
+        else if (value.woCompare(min.firstElement(), false) < 0) {
+            min = value.wrap("");
+        }
+        else if (value.woCompare(max.firstElement(), false) > 0) {
+            max = value.wrap("");
+        }
+    }
+
+    ExtentSynopses::ExtentSynopses() { }
+
+    bool ExtentSynopses::fieldsFor(const MatchExpression* filter,
+                                   std::vector<std::string>* fields) {
+        fields->clear();
+        if (NULL == filter)
+            return false;
+
+        if (MatchExpression::AND == filter->matchType()) {
+            for (size_t i = 0; i < filter->numChildren(); ++i) {
+                addField(filter->getChild(i), fields);
+            }
+        }
+        else {
+            addField(filter, fields);
+        }
+
+        return !fields->empty();
+    }
+
+    uint64_t ExtentSynopses::writeEpoch() const {
+        return _writeEpoch.load();
+    }
+
+    void ExtentSynopses::store(const DiskLoc& extent, const FieldRanges& ranges, uint64_t epoch) {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+
+        // Count a new summary before checking the epoch.  A write that bumps the epoch after the
+        // check then sees the count, and widens the summary once we release the mutex.
+        ExtentMap::iterator entry = _extents.find(extent);
+        const bool added = entry == _extents.end();
+        if (added)
+            _numExtents.fetchAndAdd(1);
+
+        if (epoch != _writeEpoch.load()) {
+            if (added)
+                _numExtents.fetchAndSubtract(1);
+            return;
+        }
+
+        FieldRanges& existing = added ? _extents[extent] : entry->second;
+        for (FieldRanges::const_iterator it = ranges.begin(); it != ranges.end(); ++it) {
+            FieldRanges::iterator found = existing.find(it->first);
+            if (found != existing.end()) {
+                // A range read from the whole extent is at least as tight as a widened one.
+                found->second = it->second;
+            }
+            else if (existing.size() < kMaxFields) {
+                existing.insert(*it);
+            }
+        }
+    }
+
+    bool ExtentSynopses::canSkip(const DiskLoc& extent, const MatchExpression* filter) const {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        ExtentMap::const_iterator it = _extents.find(extent);
+        if (it == _extents.end())
+            return false;
+
+        return rangesExclude(it->second, filter);
+    }
+
+    bool ExtentSynopses::noteWriteNeedsDoc() {
+        _writeEpoch.fetchAndAdd(1);
+        return _numExtents.load() != 0;
+    }
+
+    void ExtentSynopses::noteWrite(const DiskLoc& extent, const BSONObj& doc) {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+
+        ExtentMap::iterator it = _extents.find(extent);
+        if (it == _extents.end())
+            return;
+
+        FieldRanges& ranges = it->second;
+        for (FieldRanges::iterator field = ranges.begin(); field != ranges.end(); ++field) {
+            field->second.add(doc.getField(field->first));
+        }
+    }
+
+    void ExtentSynopses::clear() {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        _writeEpoch.fetchAndAdd(1);
+        _extents.clear();
+        _numExtents.store(0);
+    }
+
+}  // namespace mongo
@@ -0,0 +1,151 @@
+// extent_synopses.h
+
+/**
+*    Copyright (C) 2014 MongoDB Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "mongo/db/diskloc.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/cstdint.h"
+
+namespace mongo {
+
+    class MatchExpression;
+
+    /**
+     * In-memory min/max summaries of top-level field values, one per extent of a collection.
+     *
+     * A collection scan whose filter constrains a top-level field records the range of that
+     * field for each extent it reads end to end.  Later scans consult the summaries to skip
+     * extents that can't hold a match.  Writes widen the summary of the extent they land in so
+     * it stays correct; deletes leave it alone, which only makes it looser.  Nothing here is
+     * persisted, so summaries are rebuilt by scans after a restart.
+     */
+    class ExtentSynopses {
+    public:
+        /**
+         * The range of one field over the records of an extent.  A missing field counts as null.
+         */
+        struct FieldRange {
+            FieldRange() : usable(true) { }
+
+            /**
+             * Widens the range to include 'e', which is EOO if the field is missing.
+             */
+            void add(const BSONElement& e);
+
+            // One element objects with an empty field name.  Empty until something is added.
+            BSONObj min;
+            BSONObj max;
+
+            // False once an array or an oversized value has been seen.  Arrays match predicates
+            // on their elements, so a range over whole values says nothing useful about them.
+            bool usable;
+        };
+
+        typedef std::map<std::string, FieldRange> FieldRanges;
+
+        /**
+         * At most this many fields are summarized for a single extent.
+         */
+        static const size_t kMaxFields = 4;
+
+        /**
+         * Values larger than this make a field's range unusable rather than being copied.
+         */
+        static const int kMaxValueSize = 256;
+
+        ExtentSynopses();
+
+        /**
+         * Fills 'fields' with the fields worth summarizing to answer 'filter': the top-level
+         * paths of comparisons that are the filter itself or children of a top-level $and.
+         * Returns false if there are none.
+         */
+        static bool fieldsFor(const MatchExpression* filter, std::vector<std::string>* fields);
+
+        /**
+         * Increases on every write to the collection.  A scan reads this when it starts an extent
+         * and hands it back to store() so that ranges racing with a write are thrown away.
+         */
+        uint64_t writeEpoch() const;
+
+        /**
+         * Records 'ranges', gathered from every record in 'extent', unless the collection has
+         * been written to since 'epoch'.
+         */
+        void store(const DiskLoc& extent, const FieldRanges& ranges, uint64_t epoch);
+
+        /**
+         * Returns true if the summary of 'extent' shows that no record in it can match 'filter'.
+         */
+        bool canSkip(const DiskLoc& extent, const MatchExpression* filter) const;
+
+        /**
+         * Called for every write to the collection.  Returns false, without taking the mutex,
+         * when no extent has a summary, in which case the write has been noted and noteWrite()
+         * need not be called.
+         */
+        bool noteWriteNeedsDoc();
+
+        /**
+         * Called for every document written to 'extent', whether inserted or updated in place,
+         * once noteWriteNeedsDoc() returned true.
+         */
+        void noteWrite(const DiskLoc& extent, const BSONObj& doc);
+
+        /**
+         * Forgets every summary.  Must be called when extents are freed or records move between
+         * them behind the collection's back, e.g. by compact or truncate.
+         */
+        void clear();
+
+    private:
+        typedef std::map<DiskLoc, FieldRanges> ExtentMap;
+
+        // Scans add summaries under a read lock, so concurrent readers need this.
+        mutable boost::mutex _mutex;
+
+        ExtentMap _extents;
+
+        // Number of entries in _extents.  Readable without the mutex so that writes to a
+        // collection without summaries don't take it.
+        AtomicUInt32 _numExtents;
+
+        AtomicUInt64 _writeEpoch;
+    };
+
+}  // namespace mongo
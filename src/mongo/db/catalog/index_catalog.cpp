@@ -306,7 +306,8 @@ namespace mongo {
 
     Status IndexCatalog::createIndex( BSONObj spec,
                                       bool mayInterrupt,
-                                      ShutdownBehavior shutdownBehavior ) {
+                                      ShutdownBehavior shutdownBehavior,
+                                      bool dropDups ) {
         Lock::assertWriteLocked( _collection->_database->name() );
         _checkMagic();
         Status status = _checkUnfinished();
@@ -352,7 +353,7 @@ namespace mongo {
             // IndexCatalog can be dropped, which means both the Collection and IndexCatalog
             // can be destructed out from under us.  The runner used by the index build will
             // throw a particular exception when it detects that this occurred.
-            buildAnIndex( _collection, entry, mayInterrupt );
+            buildAnIndex( _collection, entry, mayInterrupt, dropDups );
             indexBuildBlock.success();
 
             InProgressIndexesMap::iterator it = _inProgressIndexes.find(descriptor);
@@ -706,7 +707,7 @@ namespace mongo {
         return Status::OK();
     }
 
-    Status IndexCatalog::ensureHaveIdIndex() {
+    Status IndexCatalog::ensureHaveIdIndex( bool dropDups ) {
         if ( _details->isSystemFlagSet( NamespaceDetails::Flag_HaveIdIndex ) )
             return Status::OK();
 
@@ -718,7 +719,7 @@ namespace mongo {
         b.append( "key", _idObj );
         BSONObj o = b.done();
 
-        Status s = createIndex( o, false );
+        Status s = createIndex( o, false, SHUTDOWN_CLEANUP, dropDups );
         if ( s.isOK() || s.code() == ErrorCodes::IndexAlreadyExists ) {
             _details->setSystemFlag( NamespaceDetails::Flag_HaveIdIndex );
             return Status::OK();
@@ -967,6 +968,11 @@ namespace mongo {
         default:
             massert( 16632, "current 'expireAfterSeconds' is not a number", false );
         }
+
+        Collection* systemIndexes =
+            _collection->_database->getCollection( _collection->_database->_indexesName );
+        if ( systemIndexes )
+            systemIndexes->notifyOfInPlaceUpdate( indexDetails->info );
     }
 
     bool IndexCatalog::isMultikey( const IndexDescriptor* idx ) {
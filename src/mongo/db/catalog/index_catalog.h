@@ -138,16 +138,25 @@ namespace mongo {
 
         // ---- index set modifiers ------
 
-        Status ensureHaveIdIndex();
+        /**
+         * @param dropDups - drop documents with duplicate _ids while building the index, e.g.
+         *                   after a clone that wasn't a snapshot
+         */
+        Status ensureHaveIdIndex( bool dropDups = false );
 
         enum ShutdownBehavior {
             SHUTDOWN_CLEANUP, // fully clean up this build
             SHUTDOWN_LEAVE_DIRTY // leave as if kill -9 happened, so have to deal with on restart
         };
 
+        /**
+         * @param dropDups - drop documents with duplicate keys even if 'spec' doesn't ask to;
+         *                   only this build does, the stored spec is unchanged
+         */
         Status createIndex( BSONObj spec,
                             bool mayInterrupt,
-                            ShutdownBehavior shutdownBehavior = SHUTDOWN_CLEANUP );
+                            ShutdownBehavior shutdownBehavior = SHUTDOWN_CLEANUP,
+                            bool dropDups = false );
 
         StatusWith<BSONObj> prepareSpecForCreate( const BSONObj& original ) const;
 
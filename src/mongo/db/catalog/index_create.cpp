@@ -200,7 +200,8 @@ namespace mongo {
     // throws DBException
     void buildAnIndex( Collection* collection,
                        IndexCatalogEntry* btreeState,
-                       bool mayInterrupt ) {
+                       bool mayInterrupt,
+                       bool dropDups ) {
 
         string ns = collection->ns().ns(); // our copy
         const IndexDescriptor* idx = btreeState->descriptor();
@@ -261,9 +262,11 @@ namespace mongo {
             LOG(1) << "\t bulk commit starting";
             std::set<DiskLoc> dupsToDrop;
 
+            // Passing somewhere to put the duplicates is what makes the bulk commit drop them.
+            dropDups = dropDups || idx->dropDups() || inDBRepair;
             Status status = btreeState->accessMethod()->commitBulk( bulk,
                                                                     mayInterrupt,
-                                                                    &dupsToDrop );
+                                                                    dropDups ? &dupsToDrop : NULL );
             massert( 17398,
                      str::stream() << "commitBulk failed: " << status.toString(),
                      status.isOK() );
@@ -47,9 +47,11 @@ namespace mongo {
     // Build an index in the foreground
     // If background is false, uses fast index builder
     // If background is true, uses background index builder; blocks until done.
+    // If dropDups is true, documents with duplicate keys are dropped whatever the spec says.
     void buildAnIndex( Collection* collection,
                        IndexCatalogEntry* btreeState,
-                       bool mayInterrupt );
+                       bool mayInterrupt,
+                       bool dropDups = false );
 
     class MultiIndexBlock {
         MONGO_DISALLOW_COPYING( MultiIndexBlock );
@@ -47,6 +47,7 @@
 #include "mongo/db/pagefault.h"
 #include "mongo/db/repl/rs.h"
 #include "mongo/db/repl/write_concern.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -148,16 +149,6 @@ namespace mongo {
         _collection = NULL;
     }
 
-    void yieldOrSleepFor1Microsecond() {
-#ifdef _WIN32
-        SwitchToThread();
-#elif defined(__linux__)
-        pthread_yield();
-#else
-        sleepmicros(1);
-#endif
-    }
-
     void ClientCursor::staticYield(int micros, const StringData& ns, const Record* rec) {
         bool haveReadLock = Lock::isReadLocked();
 
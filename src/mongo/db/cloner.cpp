@@ -118,17 +118,21 @@ namespace mongo {
         return res;
     }
 
-    Cloner::Cloner() { }
+    Cloner::Cloner() : _progress( NULL ) { }
 
     struct Cloner::Fun {
-        Fun( Client::Context& ctx ) : lastLog(0), context( ctx ) { }
+        Fun( Client::Context& ctx ) : lastLog(0), context( ctx ), progress( NULL ) { }
 
         void operator()( DBClientCursorBatchIterator &i ) {
-            Lock::GlobalWrite lk;
+            // Only the destination database needs to be locked, so that Cloners writing to
+            // different databases (e.g. during initial sync) don't wait for each other.
+            Lock::DBWrite lk( to_collection );
             context.relocked();
 
             bool createdCollection = false;
             Collection* collection = NULL;
+            long long batchDocs = 0;
+            long long batchBytes = 0;
 
             while( i.moreInCurrentBatch() ) {
                 if ( numSeen % 128 == 127 /*yield some*/ ) {
@@ -169,6 +173,8 @@ namespace mongo {
                 }
 
                 ++numSeen;
+                ++batchDocs;
+                batchBytes += tmp.objsize();
 
                 BSONObj js = tmp;
                 if ( isindex ) {
@@ -196,10 +202,14 @@ namespace mongo {
                     saveLast = time( 0 );
                 }
             }
+
+            if ( progress && !isindex )
+                progress->documentsCloned( to_collection, batchDocs, batchBytes );
         }
 
         time_t lastLog;
         Client::Context& context;
+        CloneProgressListener* progress;
 
         int64_t numSeen;
         bool isindex;
@@ -233,6 +243,10 @@ namespace mongo {
         f.logForRepl = logForRepl;
         f._mayYield = mayYield;
         f._mayBeInterrupted = mayBeInterrupted;
+        f.progress = _progress;
+
+        if ( _progress && !isindex )
+            _progress->collectionStarted( to_collection );
 
         int options = QueryOption_NoCursorTimeout | ( slaveOk ? QueryOption_SlaveOk : 0 );
         {
@@ -242,6 +256,9 @@ namespace mongo {
                          query, 0, options);
         }
 
+        if ( _progress && !isindex )
+            _progress->collectionFinished( to_collection );
+
         if ( indexesToBuild.size() ) {
             for (list<BSONObj>::const_iterator i = indexesToBuild.begin();
                  i != indexesToBuild.end();
@@ -340,8 +357,6 @@ namespace mongo {
         return true;
     }
 
-    extern bool inDBRepair;
-
     bool Cloner::go(Client::Context& context,
                     const string& masterHost, const CloneOptions& opts, set<string>* clonedColls,
                     string& errmsg, int* errCode) {
@@ -479,20 +494,11 @@ namespace mongo {
 
             {
                 /* we need dropDups to be true as we didn't do a true snapshot and this is before applying oplog operations
-                   that occur during the initial sync.  inDBRepair makes dropDups be true.
+                   that occur during the initial sync.
                    */
-                bool old = inDBRepair;
-                try {
-                    inDBRepair = true;
-                    Collection* c = context.db()->getCollection( to_name );
-                    if ( c )
-                        c->getIndexCatalog()->ensureHaveIdIndex();
-                    inDBRepair = old;
-                }
-                catch(...) {
-                    inDBRepair = old;
-                    throw;
-                }
+                Collection* c = context.db()->getCollection( to_name );
+                if ( c )
+                    c->getIndexCatalog()->ensureHaveIdIndex( true );
             }
         }
 
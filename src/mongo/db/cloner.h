@@ -41,6 +41,19 @@ namespace mongo {
     class DBClientCursor;
     class Query;
 
+    /**
+     * Told about the progress of the collections a Cloner copies.  Called with the destination
+     * database locked, possibly from several Cloners on different threads at once.
+     */
+    class CloneProgressListener {
+    public:
+        virtual ~CloneProgressListener() { }
+
+        virtual void collectionStarted(const string& ns) = 0;
+        virtual void documentsCloned(const string& ns, long long docs, long long bytes) = 0;
+        virtual void collectionFinished(const string& ns) = 0;
+    };
+
     class Cloner: boost::noncopyable {
     public:
         Cloner();
@@ -53,6 +66,9 @@ namespace mongo {
          */
         void setConnection( DBClientBase *c ) { _conn.reset( c ); }
 
+        /** 'listener' is not owned and must outlive this Cloner.  May be NULL. */
+        void setProgressListener( CloneProgressListener* listener ) { _progress = listener; }
+
         /** copy the entire database */
         bool go(Client::Context& ctx,
                 const string& masterHost, const CloneOptions& opts,
@@ -95,6 +111,7 @@ namespace mongo {
 
         struct Fun;
         auto_ptr<DBClientBase> _conn;
+        CloneProgressListener* _progress;
     };
 
     struct CloneOptions {
@@ -80,6 +80,7 @@ namespace mongo {
         SummaryEstimators<double, quantiles> bsonRatio;
         SummaryEstimators<double, quantiles> fillRatio;
         SummaryEstimators<double, quantiles> keyNodeRatio;
+        SummaryEstimators<double, quantiles> prefixRatio;
         SummaryEstimators<unsigned int, quantiles> keyCount;
         SummaryEstimators<unsigned int, quantiles> usedKeyCount;
 
@@ -97,10 +98,12 @@ namespace mongo {
          * @param usedKeyCount number of used (non-empty) keys in the bucket
          * @param bucket current bucket
          * @param keyNodeBytes size (number of bytes) of a KeyNode
+         * @param prefixRatio fraction of the key data bytes in the bucket that repeat a prefix of
+         *                    the preceding key
          */
         template<class Version>
         void addStats(int keyCount, int usedKeyCount, const BtreeBucket<Version>* bucket,
-                      int keyNodeBytes) {
+                      int keyNodeBytes, double prefixRatio) {
             this->numBuckets++;
             this->keyCount << keyCount;
             this->usedKeyCount << usedKeyCount;
@@ -109,6 +112,7 @@ namespace mongo {
                     (static_cast<double>(keyNodeBytes * keyCount) / bucket->bodySize());
             this->fillRatio <<
                     (1.0 - static_cast<double>(bucket->getEmptySize()) / bucket->bodySize());
+            this->prefixRatio << prefixRatio;
         }
 
         void appendTo(BSONObjBuilder& builder) const {
@@ -129,7 +133,8 @@ namespace mongo {
                     << "usedKeyCount" << usedKeyCount.statisticSummaryToBSONObj()
                     << "bsonRatio" << bsonRatio.statisticSummaryToBSONObj()
                     << "keyNodeRatio" << keyNodeRatio.statisticSummaryToBSONObj()
-                    << "fillRatio" << fillRatio.statisticSummaryToBSONObj();
+                    << "fillRatio" << fillRatio.statisticSummaryToBSONObj()
+                    << "prefixRatio" << prefixRatio.statisticSummaryToBSONObj();
         }
     };
 
@@ -277,9 +282,18 @@ namespace mongo {
 
             const _KeyNode* firstKeyNode = NULL;
             const _KeyNode* lastKeyNode = NULL;
+            long long keyBytes = 0;
+            long long sharedPrefixBytes = 0;
             for (int i = 0; i < keyCount; i++ ) {
                 const _KeyNode& kn = bucket->k(i);
 
+                Key key = KeyNode(*bucket, kn).key;
+                keyBytes += key.dataSize();
+                if (i > 0) {
+                    sharedPrefixBytes += commonPrefixBytes(KeyNode(*bucket, bucket->k(i - 1)).key,
+                                                           key);
+                }
+
                 if (kn.isUsed()) {
                     ++usedKeyCount;
                     if (i == 0) {
@@ -303,13 +317,17 @@ namespace mongo {
             }
 
 
+            double prefixRatio =
+                keyBytes == 0 ? 0 : static_cast<double>(sharedPrefixBytes) / keyBytes;
+
             // add the stats for the current bucket to the aggregates for all its ancestors and
             // the entire tree
             for (unsigned int d = 0; d < expandedAncestors.size(); ++d) {
                 AreaStats& nodeStats = _stats.nodeAt(d, expandedAncestors[d]);
-                nodeStats.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode));
+                nodeStats.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode), prefixRatio);
             }
-            _stats.wholeTree.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode));
+            _stats.wholeTree.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode),
+                                      prefixRatio);
 
             if (parentIsExpanded) {
                 NodeInfo nodeInfo;
@@ -336,11 +354,26 @@ namespace mongo {
                 _stats.perLevel.push_back(AreaStats());
             verify(_stats.perLevel.size() > depth);
             AreaStats& level = _stats.perLevel[depth];
-            level.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode));
+            level.addStats(keyCount, usedKeyCount, bucket, sizeof(_KeyNode), prefixRatio);
 
             return true;
         } 
 
+        /**
+         * @return number of leading bytes of the stored form of 'key' that are identical to the
+         *         stored form of 'prev', i.e. what a bucket could save by prefix compressing 'key'
+         *         against its predecessor
+         */
+        static int commonPrefixBytes(const Key& prev, const Key& key) {
+            const char* a = prev.data();
+            const char* b = key.data();
+            int n = std::min(prev.dataSize(), key.dataSize());
+            int i = 0;
+            while (i < n && a[i] == b[i])
+                ++i;
+            return i;
+        }
+
         vector<int> _expandNodes;
         BtreeStats _stats;
     };
@@ -429,6 +462,10 @@ namespace mongo {
      *               (same structure as keyCount)
      *           fillRatio: <stats about how full is the bucket body (bson objects + KeyNodes)>
      *               (same structure as keyCount)
+     *           prefixRatio: <stats about the fraction of key bytes in a bucket that repeat a
+     *                         prefix of the preceding key, an estimate of the space prefix
+     *                         compression would reclaim>
+     *               (same structure as keyCount)
      *       },
      *       perLevel: [ (statistics aggregated per depth)
      *           (one element with the same structure as 'overall' for each btree level,
@@ -34,6 +34,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/storage/extent.h"
+#include "mongo/db/storage/extent_manager.h"
 #include "mongo/db/structure/catalog/namespace_details.h"
 #include "mongo/util/touch_pages.h"
 
@@ -202,10 +203,44 @@ namespace mongo {
                 runners.push_back(new MultiIteratorRunner(ns.ns(), collection));
             }
 
-            // transfer iterators to runners using a round-robin distribution.
+            // Extents grow geometrically, so dealing iterators out round-robin left the cursors
+            // that got the last few extents with most of the collection.  Instead hand out the
+            // largest extents first, each to the runner with the fewest bytes so far.  The last
+            // extent is the biggest but usually only partly filled, so it is weighed by the data
+            // not accounted for by the extents before it.
             // TODO consider using a common work queue once invalidation issues go away.
+            ExtentManager& extentManager = db->getExtentManager();
+            vector<pair<long long, size_t> > extentSizes; // (bytes to scan, iterator index)
+            long long fullExtentBytes = 0;
+            size_t lastExtent = iterators.size();
             for (size_t i = 0; i < iterators.size(); i++) {
-                runners[i % runners.size()]->addIterator(iterators.releaseAt(i));
+                DiskLoc first = iterators[i]->curr();
+                long long length = 0;
+                if (!first.isNull()) {
+                    Extent* extent = extentManager.extentForV1(first);
+                    length = extent->length;
+                    if (extent->xnext.isNull())
+                        lastExtent = i;
+                    else
+                        fullExtentBytes += length;
+                }
+                extentSizes.push_back(make_pair(length, i));
+            }
+            if (lastExtent < extentSizes.size()) {
+                long long remaining = static_cast<long long>(collection->dataSize())
+                                      - fullExtentBytes;
+                extentSizes[lastExtent].first = std::max(0LL,
+                                                         std::min(remaining,
+                                                                  extentSizes[lastExtent].first));
+            }
+            std::sort(extentSizes.rbegin(), extentSizes.rend());
+
+            vector<long long> runnerBytes(runners.size(), 0);
+            for (size_t i = 0; i < extentSizes.size(); i++) {
+                size_t target = std::min_element(runnerBytes.begin(), runnerBytes.end())
+                                - runnerBytes.begin();
+                runners[target]->addIterator(iterators.releaseAt(extentSizes[i].second));
+                runnerBytes[target] += extentSizes[i].first;
             }
 
             {
@@ -87,6 +87,10 @@ namespace mongo {
     // TODO: Determine queueing behavior we want here
     MONGO_EXPORT_SERVER_PARAMETER( queueForMigrationCommit, bool, true );
 
+    // How many inserts of a batch may hold back their oplog entries, so that the entries are
+    // written together while the write lock is still held.  1 logs every insert as it is made.
+    MONGO_EXPORT_SERVER_PARAMETER( oplogGroupInsertMaxOps, int, 128 );
+
     using mongoutils::str::stream;
 
     WriteBatchExecutor::WriteBatchExecutor( const BSONObj& wc,
@@ -613,7 +617,8 @@ namespace mongo {
 
     static void singleInsert( const BSONObj& docToInsert,
                               Collection* collection,
-                              WriteOpResult* result );
+                              WriteOpResult* result,
+                              std::vector<BSONObj>* pendingOplog );
 
     static void singleCreateIndex( const BSONObj& indexDesc,
                                    Collection* collection,
@@ -643,6 +648,12 @@ namespace mongo {
          */
         explicit ExecInsertsState(const BatchedCommandRequest* aRequest);
 
+        /**
+         * Releases the write lock, if held.  Callers must unlock() first, so that inserts still
+         * waiting for the oplog are logged before the stack unwinds.
+         */
+        ~ExecInsertsState();
+
         /**
          * Acquires the write lock and client context needed to perform the current write operation.
          * Returns true on success, after which it is safe to use the "context" and "collection"
@@ -658,6 +669,19 @@ namespace mongo {
          */
         void unlock();
 
+        /**
+         * Returns where the current insert should queue its oplog entry, or NULL if it should
+         * log itself.  Only valid if hasLock().
+         */
+        std::vector<BSONObj>* pendingOplog();
+
+        /**
+         * Logs the queued inserts in one pass over the oplog once enough of them have built up,
+         * or when the journal wants a commit.  The force flag logs them regardless.  The inserts
+         * are already in the collection, so failing to log them is fatal.
+         */
+        void flushOplog(bool force);
+
         /**
          * Returns true if this executor has the lock on the target database.
          */
@@ -697,6 +721,10 @@ namespace mongo {
 
         // Target collection.
         Collection* _collection;
+
+        // Inserts made under the current write lock that are not in the oplog yet.  Always
+        // flushed before the lock is released, so no other operation can see them unlogged.
+        std::vector<BSONObj> _pendingOplog;
     };
 
     void WriteBatchExecutor::bulkExecute( const BatchedCommandRequest& request,
@@ -793,39 +821,51 @@ namespace mongo {
         // particularly on operation interruption.  These kinds of errors necessarily prevent
         // further insertOne calls, and stop the batch.  As a result, the only expected source of
         // such exceptions are interruptions.
+        //
+        // Inserts may be queued for the oplog while the lock is held (see flushOplog()), so the
+        // lock is always released through unlock() before leaving, whether the batch finished,
+        // stopped at an error or is unwinding from an exception.
         ExecInsertsState state(&request);
         normalizeInserts(request, &state.normalizedInserts);
 
         ElapsedTracker elapsedTracker(128, 10); // 128 hits or 10 ms, matching RunnerYieldPolicy's
 
-        for (state.currIndex = 0;
-             state.currIndex < state.request->sizeWriteOps();
-             ++state.currIndex) {
-
-            if (elapsedTracker.intervalHasElapsed()) {
-                // Consider yielding between inserts.
-
-                if (state.hasLock()) {
-                    int micros = ClientCursor::suggestYieldMicros();
-                    if (micros > 0) {
-                        state.unlock();
-                        killCurrentOp.checkForInterrupt();
-                        sleepmicros(micros);
+        try {
+            for (state.currIndex = 0;
+                 state.currIndex < state.request->sizeWriteOps();
+                 ++state.currIndex) {
+
+                if (elapsedTracker.intervalHasElapsed()) {
+                    // Consider yielding between inserts.
+
+                    if (state.hasLock()) {
+                        int micros = ClientCursor::suggestYieldMicros();
+                        if (micros > 0) {
+                            state.unlock();
+                            killCurrentOp.checkForInterrupt();
+                            sleepmicros(micros);
+                        }
                     }
+                    killCurrentOp.checkForInterrupt();
+                    elapsedTracker.resetLastTime();
                 }
-                killCurrentOp.checkForInterrupt();
-                elapsedTracker.resetLastTime();
-            }
 
-            WriteErrorDetail* error = NULL;
-            execOneInsert(&state, &error);
-            if (error) {
-                errors->push_back(error);
-                error->setIndex(state.currIndex);
-                if (request.getOrdered())
-                    return;
+                WriteErrorDetail* error = NULL;
+                execOneInsert(&state, &error);
+                if (error) {
+                    errors->push_back(error);
+                    error->setIndex(state.currIndex);
+                    if (request.getOrdered())
+                        break;
+                }
             }
         }
+        catch (...) {
+            state.unlock();
+            throw;
+        }
+
+        state.unlock();
     }
 
     void WriteBatchExecutor::execUpdate( const BatchItemRef& updateItem,
@@ -943,12 +983,55 @@ namespace mongo {
         return false;
     }
 
+    WriteBatchExecutor::ExecInsertsState::~ExecInsertsState() {
+        dassert(_pendingOplog.empty());
+        DESTRUCTOR_GUARD( unlock(); )
+    }
+
     void WriteBatchExecutor::ExecInsertsState::unlock() {
+        flushOplog(true);
         _collection = NULL;
         _context.reset();
         _writeLock.reset();
     }
 
+    std::vector<BSONObj>* WriteBatchExecutor::ExecInsertsState::pendingOplog() {
+        if (oplogGroupInsertMaxOps <= 1)
+            return NULL;
+        return &_pendingOplog;
+    }
+
+    void WriteBatchExecutor::ExecInsertsState::flushOplog(bool force) {
+        if (_pendingOplog.empty())
+            return;
+        if (!force &&
+            _pendingOplog.size() < static_cast<size_t>(oplogGroupInsertMaxOps) &&
+            !getDur().isCommitNeeded()) {
+            return;
+        }
+
+        invariant(hasLock());
+        std::vector<BSONObj> docs;
+        docs.swap(_pendingOplog);
+        bool logged = false;
+        try {
+            logInserts(_collection->ns().ns().c_str(), docs);
+            logged = true;
+        }
+        catch (const std::exception& e) {
+            severe() << "failed to log " << docs.size() << " inserts into "
+                     << _collection->ns().ns() << ": " << e.what();
+        }
+        catch (...) {
+            severe() << "failed to log " << docs.size() << " inserts into "
+                     << _collection->ns().ns();
+        }
+        // The documents are in the collection but not in the oplog; carrying on would let
+        // secondaries silently miss them.
+        fassert(17467, logged);
+        getDur().commitIfNeeded();
+    }
+
     static void insertOne(WriteBatchExecutor::ExecInsertsState* state, WriteOpResult* result) {
         invariant(state->currIndex < state->normalizedInserts.size());
         const StatusWith<BSONObj>& normalizedInsert(state->normalizedInserts[state->currIndex]);
@@ -971,7 +1054,8 @@ namespace mongo {
                 }
 
                 if (!state->request->isInsertIndexRequest()) {
-                    singleInsert(insertDoc, state->getCollection(), result);
+                    singleInsert(insertDoc, state->getCollection(), result, state->pendingOplog());
+                    state->flushOplog(false);
                 }
                 else {
                     singleCreateIndex(insertDoc, state->getCollection(), result);
@@ -1029,13 +1113,15 @@ namespace mongo {
 
     /**
      * Perform a single insert into a collection.  Requires the insert be preprocessed and the
-     * collection already has been created.
+     * collection already has been created.  If pendingOplog is given, the insert is queued there
+     * for the caller to log instead of being logged here.
      *
      * Might fault or error, otherwise populates the result.
      */
     static void singleInsert( const BSONObj& docToInsert,
                               Collection* collection,
-                              WriteOpResult* result ) {
+                              WriteOpResult* result,
+                              std::vector<BSONObj>* pendingOplog ) {
 
         const string& insertNS = collection->ns().ns();
 
@@ -1046,6 +1132,10 @@ namespace mongo {
         if ( !status.isOK() ) {
             result->setError(toWriteError(status.getStatus()));
         }
+        else if ( pendingOplog ) {
+            pendingOplog->push_back( docToInsert );
+            result->getStats().n = 1;
+        }
         else {
             logOp( "i", insertNS.c_str(), docToInsert );
             getDur().commitIfNeeded();
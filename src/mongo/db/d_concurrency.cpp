@@ -310,6 +310,9 @@ namespace mongo {
         _timer.reset();
         _stat = stat;
 
+        if ( _collectionStat )
+            _collectionStat->recordAcquireTimeMicros( _type , acquisitionTime );
+
         // increment the operation level statistics
         cc().curop()->lockStat().recordAcquireTimeMicros( _type , acquisitionTime );
 
@@ -326,6 +329,8 @@ namespace mongo {
     void Lock::ScopedLock::_recordTime( long long micros ) {
         if ( _stat )
             _stat->recordLockTimeMicros( _type , micros );
+        if ( _collectionStat )
+            _collectionStat->recordLockTimeMicros( _type , micros );
         cc().curop()->lockStat().recordLockTimeMicros( _type , micros );
     }
 
@@ -560,6 +565,23 @@ namespace mongo {
         return Lock::notnestable;
     }
 
+    /** @return the per collection stat for ns under the db lock 'lock', or null if ns is a db */
+    static CollectionLockStatPtr collectionLockStat(LockState& ls,
+                                                    WrapperForRWLock* lock,
+                                                    const StringData& ns) {
+        if ( ns.find( '.' ) == string::npos )
+            return CollectionLockStatPtr();
+        return ls.getCollectionLockStat( lock, ns );
+    }
+
+    void Lock::dropCollectionStats( const StringData& ns ) {
+        StringData db = nsToDatabaseSubstring( ns );
+        Nestable nested = n(db);
+        WrapperForRWLock* lock = nested ? nestableLocks[nested] : dblocks.get(db);
+        if ( lock )
+            lock->dropCollectionStats( ns );
+    }
+
     void Lock::DBWrite::lockDB(const string& ns) {
         fassert( 16253, !ns.empty() );
         LockState& ls = lockState();
@@ -568,6 +590,7 @@ namespace mongo {
         _locked_W=false;
         _locked_w=false; 
         _weLocked=0;
+        setCollectionStat(CollectionLockStatPtr());
 
         massert( 16186 , "can't get a DBWrite while having a read lock" , ! ls.hasAnyReadLock() );
         if( ls.isW() )
@@ -587,6 +610,8 @@ namespace mongo {
             lockTop(ls);
             if( nested )
                 lockNestable(nested);
+            if( _weLocked )
+                setCollectionStat( collectionLockStat( ls, _weLocked, ns ) );
         } 
         else {
             qlk.lock_W();
@@ -601,6 +626,7 @@ namespace mongo {
         Acquiring a(this,ls);
         _locked_r=false; 
         _weLocked=0; 
+        setCollectionStat(CollectionLockStatPtr());
 
         if ( ls.isRW() )
             return;
@@ -612,6 +638,8 @@ namespace mongo {
             lockTop(ls);
             if( nested )
                 lockNestable(nested);
+            if( _weLocked )
+                setCollectionStat( collectionLockStat( ls, _weLocked, ns ) );
         } 
         else {
             qlk.lock_R();
@@ -863,17 +891,28 @@ namespace mongo {
         BSONObj generateSection( const BSONElement& configElement ) const {
             BSONObjBuilder b;
             b.append(".", qlk.stats.report());
-            b.append("admin", nestableLocks[Lock::admin]->getStats().report());
-            b.append("local", nestableLocks[Lock::local]->getStats().report());
+            b.append("admin", report(nestableLocks[Lock::admin]));
+            b.append("local", report(nestableLocks[Lock::local]));
             {
                 DBLocksMap::ref r(dblocks);
                 for( DBLocksMap::const_iterator i = r.r.begin(); i != r.r.end(); ++i ) {
-                    b.append(i->first, i->second->getStats().report());
+                    b.append(i->first, report(i->second));
                 }
             }
             return b.obj();
         }
 
+    private:
+        /** the db level stats, with the per collection breakdown in a "collections" subobject */
+        static BSONObj report(WrapperForRWLock* lock) {
+            BSONObjBuilder b;
+            b.appendElements(lock->getStats().report());
+            BSONObjBuilder c(b.subobjStart("collections"));
+            lock->reportCollectionStats(c);
+            c.done();
+            return b.obj();
+        }
+
     } lockStatsServerStatusSection;
 
 }
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <boost/shared_ptr.hpp>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/lockstat.h"
@@ -45,6 +47,8 @@ namespace mongo {
     class WrapperForRWLock;
     class LockState;
 
+    typedef boost::shared_ptr<LockStat> CollectionLockStatPtr;
+
     class Lock : boost::noncopyable { 
     public:
         enum Nestable { notnestable=0, local, admin };
@@ -65,6 +69,12 @@ namespace mongo {
         static LockStat* globalLockStat();
         static LockStat* nestableLockStat( Nestable db );
 
+        /**
+         * Forget the per collection lock stats for ns, or for every collection of the db if ns
+         * is a db name. Called when the collection or database is dropped.
+         */
+        static void dropCollectionStats( const StringData& ns );
+
         class ScopedLock;
 
         // note: avoid TempRelease when possible. not a good thing.
@@ -118,6 +128,12 @@ namespace mongo {
         protected:
             explicit ScopedLock( char type ); 
 
+            /**
+             * Also charge acquisition and hold time to a per collection stat. Must be called
+             * before the Acquiring guard for the lock goes out of scope.
+             */
+            void setCollectionStat( const CollectionLockStatPtr& stat ) { _collectionStat = stat; }
+
         private:
             friend struct TempRelease;
             void tempRelease(); // TempRelease class calls these
@@ -134,6 +150,7 @@ namespace mongo {
             Timer _timer;
             char _type;      // 'r','w','R','W'
             LockStat* _stat; // the stat for the relevant lock to increment when we're done
+            CollectionLockStatPtr _collectionStat; // only for DBRead/DBWrite on an ns
         };
 
         // note that for these classes recursive locking is ok if the recursive locking "makes sense"
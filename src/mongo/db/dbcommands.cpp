@@ -1096,6 +1096,47 @@ namespace mongo {
         }
     }
 
+    /**
+     * Walks the deleted record lists of a non-capped collection and appends a summary of the
+     * free space they hold:
+     *     freeList: { count: <number of deleted records>,
+     *                 size: <total bytes in deleted records, scaled>,
+     *                 largest: <bytes in the largest deleted record, scaled>,
+     *                 perBucket: [ <number of deleted records in each size bucket> ] }
+     * The walk is proportional to the number of deleted records, so it is only done for verbose
+     * requests.
+     */
+    static void appendFreeListStats(const Collection* collection, int scale,
+                                    BSONObjBuilder& result) {
+        const NamespaceDetails* nsd = collection->details();
+        const RecordStore* rs = collection->getRecordStore();
+
+        long long count = 0;
+        long long size = 0;
+        int largest = 0;
+        BSONArrayBuilder perBucket;
+        for (int bucketNum = 0; bucketNum < Buckets; bucketNum++) {
+            long long bucketCount = 0;
+            for (DiskLoc dl = nsd->deletedListEntry(bucketNum); !dl.isNull(); ) {
+                const DeletedRecord* dr = rs->deletedRecordFor(dl);
+                bucketCount++;
+                size += dr->lengthWithHeaders();
+                largest = std::max(largest, dr->lengthWithHeaders());
+                dl = dr->nextDeleted();
+                killCurrentOp.checkForInterrupt();
+            }
+            count += bucketCount;
+            perBucket.append(bucketCount);
+        }
+
+        BSONObjBuilder freeList(result.subobjStart("freeList"));
+        freeList.appendNumber("count", count);
+        freeList.appendNumber("size", size / scale);
+        freeList.append("largest", largest / scale);
+        freeList.append("perBucket", perBucket.arr());
+        freeList.doneFast();
+    }
+
     class CollectionStats : public Command {
     public:
         CollectionStats() : Command( "collStats", false, "collstats" ) {
@@ -1106,7 +1147,8 @@ namespace mongo {
         virtual bool isWriteCommandForConfigServer() const { return false; }
         virtual void help( stringstream &help ) const {
             help << "{ collStats:\"blog.posts\" , scale : 1 } scale divides sizes e.g. for KB use 1024\n"
-                    "    avgObjSize - in bytes";
+                    "    avgObjSize - in bytes\n"
+                    "    verbose:true also lists extents and summarizes the deleted record lists";
         }
 
         virtual void addRequiredPrivileges(const std::string& dbname,
@@ -1173,8 +1215,11 @@ namespace mongo {
                 result.appendNumber( "max" , nsd->maxCappedDocs() );
             }
 
-            if ( verbose )
+            if ( verbose ) {
                 result.appendArray( "extents" , extents.arr() );
+                if ( !collection->isCapped() )
+                    appendFreeListStats( collection, scale, result );
+            }
 
             return true;
         }
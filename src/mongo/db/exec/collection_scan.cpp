@@ -33,6 +33,8 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/storage/extent.h"
+#include "mongo/db/structure/catalog/namespace_details.h"
 #include "mongo/util/fail_point_service.h"
 
 #include "mongo/db/client.h" // XXX-ERH
@@ -62,7 +64,10 @@ namespace mongo {
         : _workingSet(workingSet),
           _filter(filter),
           _params(params),
-          _nsDropped(false) {
+          _nsDropped(false),
+          _synopses(NULL),
+          _currEpoch(0),
+          _skippedToEnd(false) {
 
         // We pre-allocate a WSID and use it to pass up fetch requests.  It is only
         // used to pass up fetch requests and we should never use it for anything else.
@@ -84,7 +89,20 @@ namespace mongo {
                 return PlanStage::DEAD;
             }
 
-            _iter.reset( _params.collection->getIterator( _params.start,
+            DiskLoc start = _params.start;
+
+            if (start.isNull()
+                && !_params.tailable
+                && CollectionScanParams::FORWARD == _params.direction
+                && !_params.collection->isCapped()
+                && ExtentSynopses::fieldsFor(_filter, &_synopsisFields)) {
+
+                _synopses = _params.collection->infoCache()->getExtentSynopses();
+                start = enterExtent(_params.collection->details()->firstExtent());
+                _skippedToEnd = start.isNull();
+            }
+
+            _iter.reset( _params.collection->getIterator( start,
                                                           _params.tailable,
                                                           _params.direction ) );
 
@@ -92,6 +110,21 @@ namespace mongo {
             return PlanStage::NEED_TIME;
         }
 
+        // Crossing into the next extent.  Skip ahead if the synopses say it can't match.
+        if (NULL != _synopses && !isEOF() && _iter->curr() == _nextExtentStart) {
+            finishExtent();
+            DiskLoc resume = enterExtent(_nextExtent);
+            if (resume.isNull()) {
+                _skippedToEnd = true;
+                return PlanStage::IS_EOF;
+            }
+            if (resume != _iter->curr()) {
+                _iter.reset(_params.collection->getIterator(resume,
+                                                            false,
+                                                            CollectionScanParams::FORWARD));
+            }
+        }
+
         // See if the record we're about to access is in memory.  If it's not, pass a fetch
         // request up.
         if (!isEOF()) {
@@ -127,22 +160,61 @@ namespace mongo {
 
         WorkingSetID id = _workingSet->allocate();
         WorkingSetMember* member = _workingSet->get(id);
-        member->loc = nextLoc;
-        member->obj = member->loc.obj();
         member->state = WorkingSetMember::LOC_AND_UNOWNED_OBJ;
 
-        ++_specificStats.docsTested;
+        // Records that fail the filter are skipped here instead of returning NEED_TIME for each
+        // one, which would cost a call through every stage above us per rejected record.  The
+        // same member is reused for every candidate.  We give up after kMaxRecordsPerWork
+        // records, or as soon as the next record isn't in memory, so fetch requests happen just
+        // as they would one record at a time.  Every record tested is charged as a work, so
+        // plan ranking sees the same productivity as it would one record at a time.
+        size_t tested = 1;
+        for (;; ++tested) {
+            member->loc = nextLoc;
+            member->obj = member->loc.obj();
 
-        if (Filter::passes(member, _filter)) {
-            *out = id;
-            ++_commonStats.advanced;
-            return PlanStage::ADVANCED;
-        }
-        else {
-            _workingSet->free(id);
-            ++_commonStats.needTime;
-            return PlanStage::NEED_TIME;
+            ++_specificStats.docsTested;
+
+            if (NULL != _synopses && !_currExtent.isNull()) {
+                for (ExtentSynopses::FieldRanges::iterator it = _currRanges.begin();
+                     it != _currRanges.end();
+                     ++it) {
+                    it->second.add(member->obj.getField(it->first));
+                }
+                if (_iter->isEOF()) {
+                    finishExtent();
+                }
+            }
+
+            if (Filter::passes(member, _filter)) {
+                *out = id;
+                _commonStats.works += tested - 1;
+                _commonStats.needTime += tested - 1;
+                ++_commonStats.advanced;
+                return PlanStage::ADVANCED;
+            }
+
+            if (tested >= kMaxRecordsPerWork || isEOF()) {
+                break;
+            }
+
+            DiskLoc curr = _iter->curr();
+            if (curr.isNull() || !diskLocInMemory(curr)) {
+                break;
+            }
+
+            // Let the next call to work() decide whether to read the next extent.
+            if (NULL != _synopses && curr == _nextExtentStart) {
+                break;
+            }
+
+            nextLoc = _iter->getNext();
         }
+
+        _workingSet->free(id);
+        _commonStats.works += tested - 1;
+        _commonStats.needTime += tested;
+        return PlanStage::NEED_TIME;
     }
 
     bool CollectionScan::isEOF() {
@@ -150,6 +222,7 @@ namespace mongo {
             return true;
         }
         if (_nsDropped) { return true; }
+        if (_skippedToEnd) { return true; }
         if (NULL == _iter) { return false; }
         return _iter->isEOF();
     }
@@ -170,6 +243,12 @@ namespace mongo {
             _iter->invalidate(dl);
         }
 
+        // Without the first record of the next extent we can't tell where the current one ends,
+        // so stop gathering ranges and skipping extents for the rest of the scan.
+        if (NULL != _synopses && dl == _nextExtentStart) {
+            _synopses = NULL;
+        }
+
         // We might have 'dl' inside of the WSM that _wsidForFetch references.  This is OK because
         // the runner who handles the fetch request does so before releasing any locks (and allowing
         // the DiskLoc to be deleted).  We also don't use any data in the WSM referenced by
@@ -193,6 +272,53 @@ namespace mongo {
         }
     }
 
+    DiskLoc CollectionScan::enterExtent(DiskLoc extent) {
+        _currExtent = DiskLoc();
+        _nextExtent = DiskLoc();
+        _nextExtentStart = DiskLoc();
+
+        Extent* e = NULL;
+        for (; !extent.isNull(); extent = e->xnext) {
+            e = _params.collection->getExtent(extent);
+            if (e->firstRecord.isNull()) {
+                continue;
+            }
+            if (!_synopses->canSkip(extent, _filter)) {
+                break;
+            }
+            ++_specificStats.extentsSkipped;
+        }
+
+        if (extent.isNull()) {
+            return DiskLoc();
+        }
+
+        for (_nextExtent = e->xnext; !_nextExtent.isNull(); ) {
+            Extent* next = _params.collection->getExtent(_nextExtent);
+            if (!next->firstRecord.isNull()) {
+                _nextExtentStart = next->firstRecord;
+                break;
+            }
+            _nextExtent = next->xnext;
+        }
+
+        _currExtent = extent;
+        _currEpoch = _synopses->writeEpoch();
+        _currRanges.clear();
+        for (size_t i = 0; i < _synopsisFields.size(); ++i) {
+            _currRanges[_synopsisFields[i]] = ExtentSynopses::FieldRange();
+        }
+
+        return e->firstRecord;
+    }
+
+    void CollectionScan::finishExtent() {
+        if (!_currExtent.isNull()) {
+            _synopses->store(_currExtent, _currRanges, _currEpoch);
+            _currExtent = DiskLoc();
+        }
+    }
+
     PlanStageStats* CollectionScan::getStats() {
         _commonStats.isEOF = isEOF();
         auto_ptr<PlanStageStats> ret(new PlanStageStats(_commonStats, STAGE_COLLSCAN));
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "mongo/db/catalog/extent_synopses.h"
 #include "mongo/db/diskloc.h"
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -58,12 +59,32 @@ namespace mongo {
         virtual void recoverFromYield();
 
         virtual PlanStageStats* getStats();
+        /**
+         * The most records a single call to work() will test against the filter before returning
+         * NEED_TIME.  Bounds how long we go between yield opportunities: a runner counts one
+         * call to work() toward its yield interval however many records it tested, so only the
+         * time based yield trigger sees the records skipped within one call.
+         */
+        static const size_t kMaxRecordsPerWork = 128;
+
     private:
         /**
          * Returns true if the record 'loc' references is in memory, false otherwise.
          */
         bool diskLocInMemory(DiskLoc loc);
 
+        /**
+         * Returns the first record of the first extent, starting at 'extent', that the extent
+         * synopses don't rule out, and begins gathering field ranges for that extent.  Returns
+         * DiskLoc() if every remaining extent was ruled out.
+         */
+        DiskLoc enterExtent(DiskLoc extent);
+
+        /**
+         * Hands the ranges gathered over the extent we just read in full to the synopses.
+         */
+        void finishExtent();
+
         // WorkingSet is not owned by us.
         WorkingSet* _workingSet;
 
@@ -82,6 +103,29 @@ namespace mongo {
         // and reuse it for any future fetch requests, changing the DiskLoc as appropriate.
         WorkingSetID _wsidForFetch;
 
+        // Extent skipping is only done for full forward scans of non-capped collections whose
+        // filter compares a top-level field.  _synopses is NULL if we aren't doing it.  It is
+        // owned by the collection's info cache.
+        ExtentSynopses* _synopses;
+
+        // The fields whose ranges we gather while reading an extent.
+        std::vector<std::string> _synopsisFields;
+
+        // The extent we're reading and the ranges seen in it so far.
+        DiskLoc _currExtent;
+        ExtentSynopses::FieldRanges _currRanges;
+
+        // ExtentSynopses::writeEpoch() when we started reading _currExtent.
+        uint64_t _currEpoch;
+
+        // The next extent holding records, and its first record.  When the iterator reaches
+        // _nextExtentStart we're done with _currExtent.
+        DiskLoc _nextExtent;
+        DiskLoc _nextExtentStart;
+
+        // True if the synopses ruled out every extent we had left to read.
+        bool _skippedToEnd;
+
         // Stats
         CommonStats _commonStats;
         CollectionScanStats _specificStats;
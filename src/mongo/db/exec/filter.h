@@ -40,7 +40,7 @@ namespace mongo {
      */
     class WorkingSetMatchableDocument : public MatchableDocument {
     public:
-        WorkingSetMatchableDocument(WorkingSetMember* wsm) : _wsm(wsm) { }
+        WorkingSetMatchableDocument(WorkingSetMember* wsm) : _wsm(wsm), _iteratorUsed(false) { }
         virtual ~WorkingSetMatchableDocument() { }
 
         // This is only called by a $where query.  The query system must be smart enough to realize
@@ -54,7 +54,15 @@ namespace mongo {
             // BSONElementIterator does some interesting things with arrays that I don't think
             // SimpleArrayElementIterator does.
             if (_wsm->hasObj()) {
-                return new BSONElementIterator(path, _wsm->obj);
+                // Every leaf of the filter asks for an iterator in turn, so hand out the same one
+                // unless it's still in use, as BSONMatchableDocument does.  This keeps a filtered
+                // scan from doing a heap allocation per leaf per document.
+                if (_iteratorUsed) {
+                    return new BSONElementIterator(path, _wsm->obj);
+                }
+                _iteratorUsed = true;
+                _iterator.reset(path, _wsm->obj);
+                return &_iterator;
             }
 
             // NOTE: This (kind of) duplicates code in WorkingSetMember::getFieldDotted.
@@ -89,11 +97,18 @@ namespace mongo {
         }
 
         virtual void releaseIterator( ElementIterator* iterator ) const {
-            delete iterator;
+            if (iterator == &_iterator) {
+                _iteratorUsed = false;
+            }
+            else {
+                delete iterator;
+            }
         }
 
     private:
         WorkingSetMember* _wsm;
+        mutable BSONElementIterator _iterator;
+        mutable bool _iteratorUsed;
     };
 
     class IndexKeyMatchableDocument : public MatchableDocument {
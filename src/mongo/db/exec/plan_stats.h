@@ -184,7 +184,7 @@ namespace mongo {
     };
 
     struct CollectionScanStats : public SpecificStats {
-        CollectionScanStats() : docsTested(0) { }
+        CollectionScanStats() : docsTested(0), extentsSkipped(0) { }
 
         virtual SpecificStats* clone() const {
             CollectionScanStats* specific = new CollectionScanStats(*this);
@@ -193,6 +193,9 @@ namespace mongo {
 
         // How many documents did we check against our filter?
         size_t docsTested;
+
+        // How many extents did we pass over because their synopses ruled out a match?
+        size_t extentsSkipped;
     };
 
     struct DistinctScanStats : public SpecificStats {
@@ -311,7 +314,7 @@ namespace mongo {
     };
 
     struct SortStats : public SpecificStats {
-        SortStats() : forcedFetches(0), memUsage(0), memLimit(0) { }
+        SortStats() : forcedFetches(0), memUsage(0), memLimit(0), usedDisk(false) { }
 
         virtual ~SortStats() { }
 
@@ -328,6 +331,9 @@ namespace mongo {
 
         // What's our memory limit?
         size_t memLimit;
+
+        // Did we outgrow memLimit and hand our data to an external sorter?
+        bool usedDisk;
     };
 
     struct MergeSortStats : public SpecificStats {
@@ -36,13 +36,54 @@
 #include "mongo/db/index/btree_key_generator.h"
 #include "mongo/db/query/lite_parsed_query.h"
 #include "mongo/db/query/qlog.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage_options.h"
 
 namespace mongo {
 
     using std::vector;
 
-    const size_t kMaxBytes = 32 * 1024 * 1024;
+    namespace {
+
+        /**
+         * Orders the (key, document) pairs given to the external sorter.  Keys are sort keys with
+         * a packed DiskLoc appended, so 'pattern' has one more field than the sort pattern.
+         */
+        class SpillComparator {
+        public:
+            typedef std::pair<BSONObj, BSONObj> Data;
+
+            explicit SpillComparator(const BSONObj& pattern) : _pattern(pattern) { }
+
+            int operator()(const Data& lhs, const Data& rhs) const {
+                // False means ignore field names.
+                return lhs.first.woCompare(rhs.first, _pattern, false);
+            }
+
+        private:
+            BSONObj _pattern;
+        };
+
+        // DiskLocs are packed into a long long that orders the same way DiskLoc::compare does.
+        long long packDiskLoc(const DiskLoc& loc) {
+            return static_cast<long long>(loc.a()) * (1LL << 32) + loc.getOfs();
+        }
+
+        /**
+         * Members carrying computed data such as text scores can't be spilled, since only the
+         * document survives the trip through the external sorter.
+         */
+        bool canSpill(const WorkingSetMember* member) {
+            for (int i = 0; i < WSM_COMPUTED_NUM_TYPES; ++i) {
+                if (member->hasComputed(static_cast<WorkingSetComputedDataType>(i))) {
+                    return false;
+                }
+            }
+            return member->hasObj();
+        }
+
+    }  // namespace
 
     SortStageKeyGenerator::SortStageKeyGenerator(Collection* collection,
                                                  const BSONObj& sortSpec,
@@ -294,6 +335,9 @@ namespace mongo {
     bool SortStage::isEOF() {
         // We're done when our child has no more results, we've sorted the child's results, and
         // we've returned all sorted results.
+        if (NULL != _spillIterator) {
+            return _child->isEOF() && _sorted && !_spillIterator->more();
+        }
         return _child->isEOF() && _sorted && (_data.end() == _resultIterator);
     }
 
@@ -304,19 +348,14 @@ namespace mongo {
             // This is heavy and should be done as part of work().
             _sortKeyGen.reset(new SortStageKeyGenerator(_collection, _pattern, _query));
             _sortKeyComparator.reset(new WorkingSetComparator(_sortKeyGen->getSortComparator()));
-            // If limit > 1, we need to initialize _dataSet here to maintain ordered
-            // set of data items while fetching from the child stage.
-            if (_limit > 1) {
-                const WorkingSetComparator& cmp = *_sortKeyComparator;
-                _dataSet.reset(new SortableDataItemSet(cmp));
-            }
             return PlanStage::NEED_TIME;
         }
 
-        if (_memUsage > kMaxBytes) {
+        const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes);
+        if (_memUsage > maxBytes && !spillBuffer()) {
             mongoutils::str::stream ss;
             ss << "sort stage buffered data usage of " << _memUsage
-               << " bytes exceeds internal limit of " << kMaxBytes << " bytes";
+               << " bytes exceeds internal limit of " << maxBytes << " bytes";
             Status status(ErrorCodes::Overflow, ss);
             *out = WorkingSetCommon::allocateStatusMember( _ws, status);
             return PlanStage::FAILURE;
@@ -356,7 +395,18 @@ namespace mongo {
                     item.loc = member->loc;
                 }
 
-                addToBuffer(item);
+                if (NULL == _spillSorter) {
+                    addToBuffer(item);
+                }
+                else if (canSpill(member)) {
+                    addToSpillSorter(item);
+                }
+                else {
+                    Status status(ErrorCodes::Overflow,
+                                  "sort stage can't spill a result with computed data to disk");
+                    *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+                    return PlanStage::FAILURE;
+                }
 
                 ++_commonStats.needTime;
                 return PlanStage::NEED_TIME;
@@ -364,7 +414,12 @@ namespace mongo {
             else if (PlanStage::IS_EOF == code) {
                 // TODO: We don't need the lock for this.  We could ask for a yield and do this work
                 // unlocked.  Also, this is performing a lot of work for one call to work(...)
-                sortBuffer();
+                if (NULL != _spillSorter) {
+                    _spillIterator.reset(_spillSorter->done());
+                }
+                else {
+                    sortBuffer();
+                }
                 _resultIterator = _data.begin();
                 _sorted = true;
                 ++_commonStats.needTime;
@@ -396,6 +451,21 @@ namespace mongo {
         }
 
         // Returning results.
+        if (NULL != _spillIterator) {
+            verify(_spillIterator->more());
+            SpillSorter::Data next = _spillIterator->next();
+
+            // Spilled results are copies whose DiskLocs we no longer track for invalidation,
+            // so they come back without a DiskLoc, like results invalidated while buffered.
+            *out = _ws->allocate();
+            WorkingSetMember* member = _ws->get(*out);
+            member->obj = next.second.getOwned();
+            member->state = WorkingSetMember::OWNED_OBJ;
+
+            ++_commonStats.advanced;
+            return PlanStage::ADVANCED;
+        }
+
         verify(_resultIterator != _data.end());
         verify(_sorted);
         *out = _resultIterator->wsid;
@@ -451,7 +521,7 @@ namespace mongo {
 
     PlanStageStats* SortStage::getStats() {
         _commonStats.isEOF = isEOF();
-        _specificStats.memLimit = kMaxBytes;
+        _specificStats.memLimit = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes);
         _specificStats.memUsage = _memUsage;
 
         auto_ptr<PlanStageStats> ret(new PlanStageStats(_commonStats, STAGE_SORT));
@@ -475,10 +545,11 @@ namespace mongo {
      *                     Updates memory usage if item was replaced.
      *     sortBuffer() - Does nothing.
      * limit > 1:
-     *     addToBuffer() - Does not update vector. Adds item to set.
-     *                     If size of set exceeds limit, remove item from set
-     *                     with lowest key. Updates memory usage accordingly.
-     *     sortBuffer() - Copies items from set to vectors.
+     *     addToBuffer() - Keeps vector as a heap of at most 'limit' items
+     *                     with the item that sorts last on top. Once full, a
+     *                     new item replaces the top if it sorts before it.
+     *                     Updates memory usage accordingly.
+     *     sortBuffer() - Sorts the heap in place.
      */
     void SortStage::addToBuffer(const SortableDataItem& item) {
         // Holds ID of working set member to be freed at end of this function.
@@ -504,31 +575,27 @@ namespace mongo {
             }
         }
         else {
-            // Update data item set instead of vector
-            // Limit not reached - insert and return
-            vector<SortableDataItem>::size_type limit(_limit);
-            if (_dataSet->size() < limit) {
-                _dataSet->insert(item);
+            const WorkingSetComparator& cmp = *_sortKeyComparator;
+
+            // Limit not reached - push onto the heap and return.
+            if (_data.size() < _limit) {
+                _data.push_back(item);
+                std::push_heap(_data.begin(), _data.end(), cmp);
                 _memUsage += _ws->get(item.wsid)->getMemUsage();
                 return;
             }
-            // Limit will be exceeded - compare with item with lowest key
-            // If new item does not have a lower key value than last item,
-            // do nothing.
+
+            // Limit will be exceeded - compare with the item that sorts last, which is on top of
+            // the heap.  If the new item does not sort before it, do nothing.
             wsidToFree = item.wsid;
-            SortableDataItemSet::const_iterator lastItemIt = --(_dataSet->end());
-            const SortableDataItem& lastItem = *lastItemIt;
-            const WorkingSetComparator& cmp = *_sortKeyComparator;
-            if (cmp(item, lastItem)) {
+            if (cmp(item, _data.front())) {
+                std::pop_heap(_data.begin(), _data.end(), cmp);
+                SortableDataItem& lastItem = _data.back();
                 _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
                 _memUsage += _ws->get(item.wsid)->getMemUsage();
                 wsidToFree = lastItem.wsid;
-                // According to std::set iterator validity rules,
-                // it does not matter which of erase()/insert() happens first.
-                // Here, we choose to erase first to release potential resources
-                // used by the last item and to keep the scope of the iterator to a minimum.
-                _dataSet->erase(lastItemIt);
-                _dataSet->insert(item);
+                lastItem = item;
+                std::push_heap(_data.begin(), _data.end(), cmp);
             }
         }
 
@@ -553,13 +620,63 @@ namespace mongo {
             return;
         }
         else {
-            // Set already contains items in sorted order, so we simply copy the items
-            // from the set to the vector.
-            // Release the memory for the set after the copy.
-            vector<SortableDataItem> newData(_dataSet->begin(), _dataSet->end());
-            _data.swap(newData);
-            _dataSet.reset();
+            // The buffer is a heap, which sorts in place.
+            const WorkingSetComparator& cmp = *_sortKeyComparator;
+            std::sort_heap(_data.begin(), _data.end(), cmp);
+        }
+    }
+
+    bool SortStage::spillBuffer() {
+        if (!internalQueryExecAllowExternalSort) {
+            return false;
+        }
+
+        for (size_t i = 0; i < _data.size(); ++i) {
+            if (!canSpill(_ws->get(_data[i].wsid))) {
+                return false;
+            }
+        }
+
+        if (NULL == _spillSorter) {
+            const SortOptions opts = SortOptions()
+                .Limit(_limit)
+                .MaxMemoryUsageBytes(static_cast<size_t>(internalQueryExecMaxBlockingSortBytes))
+                .ExtSortAllowed()
+                .TempDir(storageGlobalParams.dbpath + "/_tmp");
+
+            // Sort on the DiskLoc too, as WorkingSetComparator does.
+            BSONObjBuilder patternBob;
+            patternBob.appendElements(_sortKeyGen->getSortComparator());
+            patternBob.append("$loc", 1);
+
+            _spillSorter.reset(SpillSorter::make(opts, SpillComparator(patternBob.obj())));
+            _specificStats.usedDisk = true;
+        }
+
+        for (size_t i = 0; i < _data.size(); ++i) {
+            addToSpillSorter(_data[i]);
+        }
+        _data.clear();
+        _memUsage = 0;
+
+        return true;
+    }
+
+    void SortStage::addToSpillSorter(const SortableDataItem& item) {
+        BSONObjBuilder keyBob(item.sortKey.objsize() + 16);
+        keyBob.appendElements(item.sortKey);
+        keyBob.append("", packDiskLoc(item.loc));
+
+        WorkingSetMember* member = _ws->get(item.wsid);
+        _spillSorter->add(keyBob.obj(), member->obj.getOwned());
+
+        if (member->hasLoc()) {
+            _wsidByDiskLoc.erase(member->loc);
         }
+        _ws->free(item.wsid);
     }
 
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+MONGO_CREATE_SORTER(mongo::BSONObj, mongo::BSONObj, mongo::SpillComparator);
@@ -30,7 +30,6 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <vector>
-#include <set>
 
 #include "mongo/db/diskloc.h"
 #include "mongo/db/jsobj.h"
@@ -38,6 +37,7 @@
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/platform/unordered_map.h"
 
 namespace mongo {
@@ -213,7 +213,7 @@ namespace mongo {
         };
 
         /**
-         * Inserts one item into data buffer (vector or set).
+         * Inserts one item into data buffer.
          * If limit is exceeded, remove item with lowest key.
          */
         void addToBuffer(const SortableDataItem& item);
@@ -221,11 +221,20 @@ namespace mongo {
         /**
          * Sorts data buffer.
          * Assumes no more items will be added to buffer.
-         * If data is stored in set, copy set
-         * contents to vector and clear set.
          */
         void sortBuffer();
 
+        /**
+         * Moves everything buffered so far into _spillSorter, creating it if needed.  Returns
+         * false if external sorting is turned off or some buffered member can't be spilled.
+         */
+        bool spillBuffer();
+
+        /**
+         * Hands 'item' to _spillSorter and frees its working set member.
+         */
+        void addToSpillSorter(const SortableDataItem& item);
+
         // Comparator for data buffer
         // Initialization follows sort key generator
         scoped_ptr<WorkingSetComparator> _sortKeyComparator;
@@ -234,16 +243,22 @@ namespace mongo {
         // _data will contain sorted data when all data is gathered
         // and sorted.
         // When _limit is greater than 1 and not all data has been gathered from child stage,
-        // _dataSet is used instead to maintain an ordered set of the incomplete data set.
-        // When the data set is complete, we copy the items from _dataSet to _data which will
-        // be used to provide the results of this stage through _resultIterator.
+        // _data is kept as a heap of at most _limit items with the item that sorts last on top,
+        // so that it can be replaced cheaply when a better item shows up.
         vector<SortableDataItem> _data;
-        typedef std::set<SortableDataItem, WorkingSetComparator> SortableDataItemSet;
-        scoped_ptr<SortableDataItemSet> _dataSet;
 
         // Iterates through _data post-sort returning it.
         vector<SortableDataItem>::iterator _resultIterator;
 
+        // Once buffered data outgrows the memory limit, it all goes to an external sorter
+        // instead of _data.  Keys are sort keys with the DiskLoc appended as a tie-breaker, and
+        // values are owned copies of the documents.
+        typedef Sorter<BSONObj, BSONObj> SpillSorter;
+        scoped_ptr<SpillSorter> _spillSorter;
+
+        // Iterates through the output of _spillSorter post-sort.
+        scoped_ptr<SpillSorter::Iterator> _spillIterator;
+
         // We buffer a lot of data and we want to look it up by DiskLoc quickly upon invalidation.
         typedef unordered_map<DiskLoc, WorkingSetID, DiskLoc::Hasher> DataMap;
         DataMap _wsidByDiskLoc;
@@ -32,11 +32,19 @@
 
 #include "mongo/db/extsort.h"
 
+#include "mongo/db/client.h"
 #include "mongo/db/kill_current_op.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage_options.h"
+#include "mongo/util/concurrency/worker_threads.h"
 
 namespace mongo {
 
+    // Threads each external sort (e.g. a foreground index build) may use to sort its runs and to
+    // write them out.  Capped at the number of cores; the default of 1 keeps sorts on the calling
+    // thread as before.
+    MONGO_EXPORT_SERVER_PARAMETER(externalSortThreads, int, 1);
+
     namespace {
         class ComparatorWithInterruptCheck {
         public:
@@ -49,7 +57,8 @@ namespace mongo {
             {}
 
             int operator() (const Data& l, const Data& r) const {
-                RARELY if (*_mayInterrupt) {
+                // The sorter's worker threads have no Client to check for interrupts with.
+                RARELY if (*_mayInterrupt && haveClient()) {
                     killCurrentOp.checkForInterrupt(!*_mayInterrupt);
                 }
 
@@ -68,7 +77,8 @@ namespace mongo {
         , _sorter(Sorter<BSONObj, DiskLoc>::make(
                     SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp")
                                  .ExtSortAllowed()
-                                 .MaxMemoryUsageBytes(maxFileSize),
+                                 .MaxMemoryUsageBytes(maxFileSize)
+                                 .SortThreads(workerThreadCount(externalSortThreads)),
                     ComparatorWithInterruptCheck(comp, _mayInterrupt)))
     {}
 }
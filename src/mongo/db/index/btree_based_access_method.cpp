@@ -30,11 +30,16 @@
 
 #include <vector>
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/status.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/catalog/collection.h"
 #include "mongo/db/extsort.h"
 #include "mongo/db/index/btree_index_cursor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/kill_current_op.h"
@@ -42,9 +47,11 @@
 #include "mongo/db/pdfile_private.h"
 #include "mongo/db/repl/is_master.h"
 #include "mongo/db/repl/rs.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/sort_phase_one.h"
 #include "mongo/db/structure/btree/btreebuilder.h"
 #include "mongo/db/structure/btree/btree_interface.h"
+#include "mongo/util/concurrency/worker_threads.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -309,10 +316,15 @@ namespace mongo {
 
     // -------
 
+    // Threads a foreground build of a plain btree index may use to generate keys.  Capped at the
+    // number of cores; the default of 1 generates keys on the building thread as before.
+    MONGO_EXPORT_SERVER_PARAMETER(indexBuildKeyGenerationThreads, int, 1);
+
     class BtreeBulk : public IndexAccessMethod {
     public:
-        BtreeBulk( BtreeBasedAccessMethod* real ) {
+        BtreeBulk( BtreeBasedAccessMethod* real, size_t keyThreads ) {
             _real = real;
+            _keyThreads = keyThreads;
         }
 
         ~BtreeBulk() {}
@@ -321,6 +333,14 @@ namespace mongo {
                               const DiskLoc& loc,
                               const InsertDeleteOptions& options,
                               int64_t* numInserted) {
+            if ( _keyThreads > 1 ) {
+                // Keys are generated a batch at a time; see generatePendingKeys().
+                _pending.push_back( loc );
+                if ( _pending.size() >= kKeyBatchSize )
+                    generatePendingKeys();
+                return Status::OK();
+            }
+
             BSONObjSet keys;
             _real->getKeys(obj, &keys);
             _phase1.addKeys(keys, loc, false);
@@ -388,7 +408,7 @@ namespace mongo {
 
             bool dupsAllowed = !entry->descriptor()->unique() ||
                 ignoreUniqueIndex(entry->descriptor());
-            bool dropDups = entry->descriptor()->dropDups() || inDBRepair;
+            bool dropDups = dupsToDrop || entry->descriptor()->dropDups() || inDBRepair;
 
             BtreeBuilder<V> btBuilder(dupsAllowed, entry);
 
@@ -451,16 +471,106 @@ namespace mongo {
             }
         }
 
+        /**
+         * Generates the keys for every record in _pending, splitting the records between up to
+         * _keyThreads threads, and feeds them to the sorter from this thread.
+         *
+         * Only the DiskLocs are buffered: the worker threads read the documents themselves while
+         * this thread, which holds the write lock, waits for them.
+         */
+        void generatePendingKeys() {
+            if ( _pending.empty() )
+                return;
+
+            const size_t threads = std::max( size_t(1),
+                                             std::min( _keyThreads,
+                                                       _pending.size() / kMinDocsPerThread ) );
+
+            std::vector<BSONObjSet> keys( _pending.size() );
+            std::vector<WorkerError> errors( threads );
+
+            {
+                boost::thread_group workers;
+                try {
+                    for ( size_t i = 1; i < threads; i++ ) {
+                        workers.create_thread( boost::bind( &BtreeBulk::generateKeys, this,
+                                                            _pending.size() * i / threads,
+                                                            _pending.size() * (i + 1) / threads,
+                                                            &keys, &errors[i] ) );
+                    }
+                }
+                catch ( ... ) {
+                    workers.join_all();
+                    throw;
+                }
+
+                generateKeys( 0, _pending.size() / threads, &keys, &errors[0] );
+                workers.join_all();
+            }
+
+            for ( size_t i = 0; i < threads; i++ ) {
+                errors[i].rethrowIfSet();
+            }
+
+            for ( size_t i = 0; i < _pending.size(); i++ ) {
+                _phase1.addKeys( keys[i], _pending[i], false );
+            }
+            _pending.clear();
+        }
+
         // -------
 
+        // Runs on a worker thread; must not touch anything but the given range.
+        void generateKeys( size_t begin, size_t end,
+                           std::vector<BSONObjSet>* keys,
+                           WorkerError* error ) {
+            try {
+                Collection* collection = _real->_btreeState->collection();
+                for ( size_t i = begin; i < end; i++ ) {
+                    _real->getKeys( collection->docFor( _pending[i] ), &(*keys)[i] );
+                }
+            }
+            catch ( const DBException& e ) {
+                error->set( e );
+            }
+            catch ( const std::exception& e ) {
+                error->set( e );
+            }
+        }
+
         Status _notAllowed() const {
             return Status( ErrorCodes::InternalError, "cannot use bulk for this yet" );
         }
 
+        // Records whose keys haven't been generated yet are buffered until there are this many.
+        static const size_t kKeyBatchSize = 64 * 1024;
+
+        // Below this many records per thread, starting threads costs more than it saves.
+        static const size_t kMinDocsPerThread = 1024;
+
         BtreeBasedAccessMethod* _real; // now owned here
         SortPhaseOne _phase1;
+        size_t _keyThreads;
+        std::vector<DiskLoc> _pending;
     };
 
+    namespace {
+        /**
+         * How many threads a bulk build of this index may use to generate keys.  Only plain btree
+         * key generation is known to be safe to run concurrently, and dropDups needs to know
+         * which document failed as soon as it is inserted.
+         */
+        size_t keyGenerationThreads( const IndexDescriptor* descriptor ) {
+            if ( descriptor->getAccessMethodName() != IndexNames::BTREE )
+                return 1;
+
+            if ( descriptor->dropDups() || inDBRepair )
+                return 1;
+
+            return workerThreadCount( indexBuildKeyGenerationThreads );
+        }
+    }
+
     int oldCompare(const BSONObj& l,const BSONObj& r, const Ordering &o); // key.cpp
 
     class BtreeExternalSortComparisonV0 : public ExternalSortComparison {
@@ -515,7 +625,7 @@ namespace mongo {
             return NULL;
         }
 
-        auto_ptr<BtreeBulk> bulk( new BtreeBulk( this ) );
+        auto_ptr<BtreeBulk> bulk( new BtreeBulk( this, keyGenerationThreads( _descriptor ) ) );
         bulk->_phase1.sortCmp.reset( getComparison( _descriptor->version(),
                                                     _descriptor->keyPattern() ) );
 
@@ -533,6 +643,9 @@ namespace mongo {
             return Status( ErrorCodes::InternalError, "trying to commit, but has data already" );
         }
 
+        // Finish phase one before touching the index itself.
+        static_cast<BtreeBulk*>( bulkRaw )->generatePendingKeys();
+
         {
             DiskLoc oldHead = _btreeState->head();
             _btreeState->setHead( DiskLoc() );
@@ -48,6 +48,8 @@ namespace mongo {
           _nestableCount(0), 
           _otherCount(0), 
           _otherLock(NULL),
+          _collectionStatLock(NULL),
+          _collectionStatGeneration(0),
           _scopedLk(NULL),
           _lockPending(false),
           _lockPendingParallelWriter(false)
@@ -244,6 +246,60 @@ namespace mongo {
     }
 
 
+    CollectionLockStatPtr LockState::getCollectionLockStat( WrapperForRWLock* lock,
+                                                          const StringData& ns ) {
+        unsigned generation = lock->getCollectionStatsGeneration();
+        if ( lock != _collectionStatLock ||
+             generation != _collectionStatGeneration ||
+             ns != _collectionStatNs ) {
+            // read the generation before the map so a concurrent drop can only make us
+            // look the stat up again next time, never keep a dropped one
+            _collectionStat = lock->getCollectionStats( ns );
+            _collectionStatLock = lock;
+            _collectionStatGeneration = generation;
+            _collectionStatNs = ns.toString();
+        }
+        return _collectionStat;
+    }
+
+
+    CollectionLockStatPtr WrapperForRWLock::getCollectionStats( const StringData& ns ) {
+        CollectionStatsMap::ref r( collectionStats );
+        CollectionStatsMap::const_iterator i = r.r.find( ns );
+        if ( i != r.r.end() )
+            return i->second;
+        if ( r.r.size() >= maxCollectionStats )
+            return CollectionLockStatPtr();
+        CollectionLockStatPtr& stat = r[ns];
+        stat.reset( new LockStat() );
+        return stat;
+    }
+
+    void WrapperForRWLock::dropCollectionStats( const StringData& ns ) {
+        CollectionStatsMap::ref r( collectionStats );
+        if ( ns.find( '.' ) != string::npos ) {
+            r.r.erase( ns );
+        }
+        else {
+            vector<string> dropped;
+            for ( CollectionStatsMap::const_iterator i = r.r.begin(); i != r.r.end(); ++i ) {
+                dropped.push_back( i->first );
+            }
+            for ( size_t i = 0; i < dropped.size(); i++ ) {
+                r.r.erase( dropped[i] );
+            }
+        }
+        collectionStatsGeneration.fetchAndAdd( 1 );
+    }
+
+    void WrapperForRWLock::reportCollectionStats( BSONObjBuilder& b ) {
+        CollectionStatsMap::ref r( collectionStats );
+        for ( CollectionStatsMap::const_iterator i = r.r.begin(); i != r.r.end(); ++i ) {
+            b.append( i->first, i->second->report() );
+        }
+    }
+
+
     Acquiring::Acquiring( Lock::ScopedLock* lock,  LockState& ls )
         : _lock( lock ), _ls( ls ){
         _ls._lockPending = true;
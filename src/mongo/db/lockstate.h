@@ -32,6 +32,9 @@
 #pragma once
 
 #include "mongo/db/d_concurrency.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/mapsf.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -94,6 +97,13 @@ namespace mongo {
         bool _batchWriter;
 
         LockStat* getRelevantLockStat();
+
+        /**
+         * @return the per collection stat for ns under the db lock 'lock'. The last one looked
+         * up is remembered so that locking the same collection again skips the map and its mutex.
+         */
+        CollectionLockStatPtr getCollectionLockStat( WrapperForRWLock* lock, const StringData& ns );
+
         void recordLockTime() { _scopedLk->recordTime(); }
         void resetLockTime() { _scopedLk->resetTime(); }
         
@@ -111,6 +121,12 @@ namespace mongo {
         string _otherName;             // which database are we locking and working with (besides local/admin) 
         WrapperForRWLock* _otherLock;  // so we don't have to check the map too often (the map has a mutex)
 
+        // last per collection stat handed out, valid while _collectionStatLock's generation matches
+        WrapperForRWLock* _collectionStatLock;
+        unsigned _collectionStatGeneration;
+        string _collectionStatNs;
+        CollectionLockStatPtr _collectionStat;
+
         // for temprelease
         // for the nonrecursive case. otherwise there would be many
         // the first lock goes here, which is ok since we can't yield recursive locks
@@ -128,10 +144,34 @@ namespace mongo {
         SimpleMutex m;
         bool sharedLatching;
         LockStat stats;
+
+        // per collection breakdown of the time spent waiting for and holding this lock.
+        // entries go away when their collection is dropped; the generation is bumped each time
+        // so that threads know to stop using a stat they cached.
+        typedef mapsf< StringMap<CollectionLockStatPtr> > CollectionStatsMap;
+        CollectionStatsMap collectionStats;
+        AtomicUInt32 collectionStatsGeneration;
     public:
         string name() const { return rw.name; }
         LockStat& getStats() { return stats; }
 
+        /** at most this many collections per db get their own stats */
+        static const size_t maxCollectionStats = 1000;
+
+        /**
+         * @return the stats for a collection of this db, or a null pointer once
+         * maxCollectionStats collections are tracked. ns must be a full namespace.
+         */
+        CollectionLockStatPtr getCollectionStats( const StringData& ns );
+
+        /** forget the stats for ns, or for all collections if ns is just a db name */
+        void dropCollectionStats( const StringData& ns );
+
+        unsigned getCollectionStatsGeneration() { return collectionStatsGeneration.load(); }
+
+        /** appends { <ns> : <LockStat::report()> } for every collection seen so far */
+        void reportCollectionStats( BSONObjBuilder& b );
+
         WrapperForRWLock(const StringData& name)
             : rw(name), m(name) {
             // For the local datbase, all operations are short,
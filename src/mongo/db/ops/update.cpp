@@ -737,6 +737,7 @@ namespace mongo {
                             where->size);
                         std::memcpy(targetPtr, sourcePtr, where->size);
                     }
+                    collection->notifyOfInPlaceUpdate(loc);
                     docWasModified = true;
                     opDebug->fastmod = true;
                 }
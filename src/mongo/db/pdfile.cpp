@@ -186,6 +186,8 @@ namespace mongo {
         Database::closeDatabase( name, db->path() );
         db = 0; // d is now deleted
 
+        Lock::dropCollectionStats( name );
+
         _deleteDataFiles( name );
     }
 
@@ -136,10 +136,14 @@ namespace {
 
     // Handles object-typed values including the top-level for ParsedDeps::extractFields
     Document documentHelper(const BSONObj& bson, const Document& neededFields) {
-        MutableDocument md(neededFields.size());
+        const size_t numNeeded = neededFields.size();
+        MutableDocument md(numNeeded);
 
+        // Once every needed field has been seen the rest of the object can't contribute anything,
+        // so stop rather than walking (and hashing the names of) the remaining fields.
+        size_t numFound = 0;
         BSONObjIterator it(bson);
-        while (it.more()) {
+        while (numFound < numNeeded && it.more()) {
             BSONElement bsonElement (it.next());
             StringData fieldName = bsonElement.fieldNameStringData();
             Value isNeeded = neededFields[fieldName];
@@ -147,22 +151,31 @@ namespace {
             if (isNeeded.missing())
                 continue;
 
+            // BSON allows repeated field names, so only count a field the first time we keep it.
+            const bool alreadyFound = !md.peek()[fieldName].missing();
+
             if (isNeeded.getType() == Bool) {
                 md.addField(fieldName, Value(bsonElement));
-                continue;
             }
-
-            dassert(isNeeded.getType() == Object);
-
-            if (bsonElement.type() == Object) {
-                Document sub = documentHelper(bsonElement.embeddedObject(), isNeeded.getDocument());
-                md.addField(fieldName, Value(sub));
+            else {
+                dassert(isNeeded.getType() == Object);
+
+                if (bsonElement.type() == Object) {
+                    Document sub = documentHelper(bsonElement.embeddedObject(),
+                                                  isNeeded.getDocument());
+                    md.addField(fieldName, Value(sub));
+                }
+                else if (bsonElement.type() == Array) {
+                    md.addField(fieldName, arrayHelper(bsonElement.embeddedObject(),
+                                                       isNeeded.getDocument()));
+                }
+                else {
+                    continue;
+                }
             }
 
-            if (bsonElement.type() == Array) {
-                md.addField(fieldName, arrayHelper(bsonElement.embeddedObject(),
-                                                   isNeeded.getDocument()));
-            }
+            if (!alreadyFound)
+                numFound++;
         }
 
         return md.freeze();
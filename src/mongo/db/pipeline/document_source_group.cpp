@@ -355,6 +355,17 @@ namespace mongo {
         vector<shared_ptr<Sorter<Value, Value>::Iterator> > sortedFiles;
         int memoryUsageBytes = 0;
 
+        // What each new group costs beyond its _id and the state its accumulators report: the
+        // vector in the hash node, the node's next pointer and bucket slot, the accumulator
+        // pointers, and an allocator header for the node, the vector buffer and each accumulator.
+        // With many small groups this dominates, so leaving it out let the real footprint run
+        // several times past _maxMemoryUsageBytes before we spilled.
+        const int mallocOverheadBytes = 2 * sizeof(void*);
+        const int groupOverheadBytes = sizeof(Accumulators)
+                                     + 2 * sizeof(void*)
+                                     + numAccumulators * sizeof(intrusive_ptr<Accumulator>)
+                                     + (2 + numAccumulators) * mallocOverheadBytes;
+
         // This loop consumes all input from pSource and buckets it based on pIdExpression.
         while (boost::optional<Document> input = pSource->getNext()) {
             if (memoryUsageBytes > _maxMemoryUsageBytes) {
@@ -383,7 +394,7 @@ namespace mongo {
             const bool inserted = groups.size() != oldSize;
 
             if (inserted) {
-                memoryUsageBytes += id.getApproximateSize();
+                memoryUsageBytes += id.getApproximateSize() + groupOverheadBytes;
 
                 // Add the accumulators
                 group.reserve(numAccumulators);
@@ -33,12 +33,16 @@
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/instance.h"
 #include "mongo/db/pdfile.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/get_runner.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_solution.h"
 #include "mongo/s/d_logic.h"
 
 namespace mongo {
@@ -62,6 +66,152 @@ namespace {
     private:
         DBDirectClient _client;
     };
+
+    /**
+     * Returns true if some non-multikey btree index on 'collection' has every field in 'deps' in
+     * its key pattern.  Only top-level fields are considered since those are the only ones the
+     * planner will cover with an index scan.
+     */
+    bool depsCoveredByIndex(Collection* collection, const DepsTracker& deps) {
+        if (deps.needWholeDocument || deps.needTextScore || deps.fields.empty())
+            return false;
+
+        for (set<string>::const_iterator it = deps.fields.begin(); it != deps.fields.end(); ++it) {
+            if (it->find('.') != string::npos)
+                return false;
+        }
+
+        IndexCatalog::IndexIterator ii = collection->getIndexCatalog()->getIndexIterator(false);
+        while (ii.more()) {
+            const IndexDescriptor* desc = ii.next();
+            if (desc->getAccessMethodName() != IndexNames::BTREE || desc->isMultikey())
+                continue;
+
+            const BSONObj& keyPattern = desc->keyPattern();
+            bool covered = true;
+            for (set<string>::const_iterator it = deps.fields.begin();
+                 covered && it != deps.fields.end();
+                 ++it) {
+                covered = keyPattern.hasField(*it);
+            }
+
+            if (covered)
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Returns true if no document missing the field can match 'predicate', the query element for
+     * that field.  Conservative: false unless the predicate obviously requires a value.
+     */
+    bool predicateRequiresValue(const BSONElement& predicate) {
+        switch (predicate.type()) {
+        case jstNULL:
+        case Undefined:
+        case MinKey:
+        case MaxKey:
+        case RegEx:
+            return false;
+        case Object: {
+            BSONObj ops = predicate.embeddedObject();
+            if (ops.isEmpty() || ops.firstElementFieldName()[0] != '$')
+                return true; // equality to a subdocument
+
+            // The operators are and-ed, so any one that needs a value is enough.
+            BSONForEach(op, ops) {
+                const StringData name = op.fieldNameStringData();
+                if (name == "$gt" || name == "$gte" || name == "$lt" || name == "$lte") {
+                    if (!op.isNull() && op.type() != Undefined
+                            && op.type() != MinKey && op.type() != MaxKey)
+                        return true;
+                }
+                else if (name == "$exists") {
+                    if (op.trueValue())
+                        return true;
+                }
+                else if (name == "$in" && op.type() == Array) {
+                    bool allValues = !op.embeddedObject().isEmpty();
+                    BSONForEach(value, op.embeddedObject()) {
+                        if (value.isNull() || value.type() == Undefined || value.type() == RegEx)
+                            allValues = false;
+                    }
+                    if (allValues)
+                        return true;
+                }
+            }
+            return false;
+        }
+        default:
+            return true; // equality to a value
+        }
+    }
+
+    /** Returns true if every document matching 'query' must have the top-level 'field' */
+    bool queryRequiresField(const BSONObj& query, const StringData& field) {
+        BSONForEach(e, query) {
+            if (e.fieldNameStringData() == field && predicateRequiresValue(e))
+                return true;
+
+            if (e.fieldNameStringData() == "$and" && e.type() == Array) {
+                BSONForEach(clause, e.embeddedObject()) {
+                    if (clause.type() == Object
+                            && queryRequiresField(clause.embeddedObject(), field))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns true if 'projection' can be passed to the query so that it is answered from an
+     * index alone.  An index holds null for a missing field, so a covered plan would turn
+     * missing fields into nulls, which the pipeline can tell apart; that rules out any field the
+     * query does not require to be present.  And since the projection only pays off when no
+     * documents are fetched, every plan the planner could pick has to be covered.
+     */
+    bool useCoveredProjection(Collection* collection,
+                              const NamespaceString& ns,
+                              const BSONObj& queryObj,
+                              const BSONObj& sortObj,
+                              const DepsTracker& deps,
+                              size_t runnerOptions) {
+        if (!collection || !depsCoveredByIndex(collection, deps))
+            return false;
+
+        for (set<string>::const_iterator it = deps.fields.begin(); it != deps.fields.end(); ++it) {
+            if (*it != "_id" && !queryRequiresField(queryObj, *it))
+                return false;
+        }
+
+        CanonicalQuery* rawCq;
+        Status status =
+            CanonicalQuery::canonicalize(ns, queryObj, sortObj, deps.toProjection(), &rawCq);
+        if (!status.isOK())
+            return false;
+        scoped_ptr<CanonicalQuery> cq(rawCq);
+
+        QueryPlannerParams plannerParams;
+        plannerParams.options = runnerOptions;
+        fillOutPlannerParams(collection, cq.get(), &plannerParams);
+
+        vector<QuerySolution*> solutions;
+        if (!QueryPlanner::plan(*cq, plannerParams, &solutions).isOK())
+            return false;
+
+        bool covered = !solutions.empty();
+        for (size_t i = 0; i < solutions.size(); i++) {
+            const QuerySolutionNode* root = solutions[i]->root.get();
+            if (!root || root->getType() != STAGE_PROJECTION
+                      || root->children.empty() || root->children[0]->fetched()) {
+                covered = false;
+            }
+            delete solutions[i];
+        }
+        return covered;
+    }
 }
 
     boost::shared_ptr<Runner> PipelineD::prepareCursorSource(
@@ -108,11 +258,6 @@ namespace {
         // Find the set of fields in the source documents depended on by this pipeline.
         const DepsTracker deps = pPipeline->getDependencies(queryObj);
 
-        // Passing query an empty projection since it is faster to use ParsedDeps::extractFields().
-        // This will need to change to support covering indexes (SERVER-12015). There is an
-        // exception for textScore since that can only be retrieved by a query projection.
-        const BSONObj projectionForQuery = deps.needTextScore ? deps.toProjection() : BSONObj();
-
         /*
           Look for an initial sort; we'll try to add this to the
           Cursor we create.  If we're successful in doing that (further down),
@@ -152,15 +297,25 @@ namespace {
                                    | QueryPlannerParams::INCLUDE_SHARD_FILTER
                                    | QueryPlannerParams::NO_BLOCKING_SORT
                                    ;
+
+        // Passing query an empty projection since it is faster to use ParsedDeps::extractFields().
+        // There are two exceptions: textScore can only be retrieved by a query projection, and
+        // when the query can be answered from an index alone the projection lets it do so
+        // without fetching documents (SERVER-12015).
+        const BSONObj projection = deps.toProjection();
+        const BSONObj noProjection;
         boost::shared_ptr<Runner> runner;
         bool sortInRunner = false;
         if (sortStage) {
             CanonicalQuery* cq;
+            const bool project = deps.needTextScore ||
+                useCoveredProjection(collection, pExpCtx->ns, queryObj, sortObj, deps,
+                                     runnerOptions);
             Status status =
                 CanonicalQuery::canonicalize(pExpCtx->ns,
                                              queryObj,
                                              sortObj,
-                                             projectionForQuery,
+                                             project ? projection : noProjection,
                                              &cq);
             Runner* rawRunner;
             if (status.isOK() && getRunner(collection, cq, &rawRunner, runnerOptions).isOK()) {
@@ -178,12 +333,15 @@ namespace {
 
         if (!runner.get()) {
             const BSONObj noSort;
+            const bool project = deps.needTextScore ||
+                useCoveredProjection(collection, pExpCtx->ns, queryObj, noSort, deps,
+                                     runnerOptions);
             CanonicalQuery* cq;
             uassertStatusOK(
                 CanonicalQuery::canonicalize(pExpCtx->ns,
                                              queryObj,
                                              noSort,
-                                             projectionForQuery,
+                                             project ? projection : noProjection,
                                              &cq));
 
             Runner* rawRunner;
@@ -41,6 +41,7 @@
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/qlog.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/type_explain.h"
 
@@ -57,7 +58,8 @@ namespace mongo {
           _exec(new PlanExecutor(ws, root, collection)),
           _alreadyProduced(false),
           _updatedCache(false),
-          _killed(false) { }
+          _killed(false),
+          _decisionWorks(0) { }
 
     CachedPlanRunner::~CachedPlanRunner() {
         // The runner may produce all necessary results without hitting EOF.  In this case, we still
@@ -70,6 +72,11 @@ namespace mongo {
     Runner::RunnerState CachedPlanRunner::getNext(BSONObj* objOut, DiskLoc* dlOut) {
         Runner::RunnerState state = _exec->getNext(objOut, dlOut);
 
+        if (!_alreadyProduced
+            && (Runner::RUNNER_ADVANCED == state || Runner::RUNNER_EOF == state)) {
+            checkDecisionWorks();
+        }
+
         if (Runner::RUNNER_ADVANCED == state) {
             // Indicate that the plan executor already produced results.
             _alreadyProduced = true;
@@ -208,6 +215,38 @@ namespace mongo {
         }
     }
 
+    void CachedPlanRunner::checkDecisionWorks() {
+        if (0 == _decisionWorks || _updatedCache || _killed) {
+            return;
+        }
+
+        scoped_ptr<PlanStageStats> stats(_exec->getStats());
+        if (NULL == stats.get()) {
+            return;
+        }
+
+        const double ratio = static_cast<double>(stats->common.works) / _decisionWorks;
+        if (ratio <= internalQueryCacheEvictionRatio) {
+            return;
+        }
+
+        // Keep running the plan we have, but don't let it be chosen again without competition.
+        // There's nothing left to give feedback on once the entry is gone.
+        _updatedCache = true;
+
+        Database* db = cc().getContext()->db();
+        if (NULL == db) { return; }
+        Collection* collection = db->getCollection(_canonicalQuery->ns());
+        if (NULL == collection) { return; }
+        invariant( collection == _collection );
+
+        LOG(1) << _canonicalQuery->ns() << ": evicting cached plan that took "
+               << stats->common.works << " works before its first result, " << _decisionWorks
+               << " when cached; query: " << _canonicalQuery->toStringShort();
+
+        collection->infoCache()->getPlanCache()->remove(*_canonicalQuery);
+    }
+
     void CachedPlanRunner::setBackupPlan(QuerySolution* qs, PlanStage* root, WorkingSet* ws) {
         _backupSolution.reset(qs);
         _backupPlan.reset(new PlanExecutor(ws, root, _collection));
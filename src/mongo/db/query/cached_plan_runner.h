@@ -96,9 +96,22 @@ namespace mongo {
          */
         void setBackupPlan(QuerySolution* qs, PlanStage* root, WorkingSet* ws);
 
+        /**
+         * Tells the runner how many works the cached plan needed during the trial run that put it
+         * in the cache.  If the plan needs far more than that to produce its first result, the
+         * cache entry is evicted so the next query replans.  Zero disables the check.
+         */
+        void setDecisionWorks(size_t works) { _decisionWorks = works; }
+
     private:
         void updateCache();
 
+        /**
+         * Evicts our cache entry if the plan took more than internalQueryCacheEvictionRatio
+         * times its trial works to produce its first result (or to hit EOF).
+         */
+        void checkDecisionWorks();
+
         const Collection* _collection;
 
         boost::scoped_ptr<CanonicalQuery> _canonicalQuery;
@@ -121,6 +134,9 @@ namespace mongo {
 
         // Has the runner been killed?
         bool _killed;
+
+        // Works of the winning plan's trial run when it was cached, or zero if unknown.
+        size_t _decisionWorks;
     };
 
 }  // namespace mongo
@@ -487,6 +487,7 @@ namespace mongo {
         else if (STAGE_COLLSCAN == stats.stageType) {
             CollectionScanStats* spec = static_cast<CollectionScanStats*>(stats.specific.get());
             bob->appendNumber("docsTested", spec->docsTested);
+            bob->appendNumber("extentsSkipped", spec->extentsSkipped);
         }
         else if (STAGE_FETCH == stats.stageType) {
             FetchStats* spec = static_cast<FetchStats*>(stats.specific.get());
@@ -546,6 +547,7 @@ namespace mongo {
             bob->appendNumber("forcedFetches", spec->forcedFetches);
             bob->appendNumber("memUsage", spec->memUsage);
             bob->appendNumber("memLimit", spec->memLimit);
+            bob->appendBool("usedDisk", spec->usedDisk);
         }
         else if (STAGE_SORT_MERGE == stats.stageType) {
             MergeSortStats* spec = static_cast<MergeSortStats*>(stats.specific.get());
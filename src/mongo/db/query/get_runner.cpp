@@ -30,8 +30,10 @@
 
 #include <limits>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/query/cached_plan_runner.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/eof_runner.h"
@@ -54,10 +56,33 @@
 #include "mongo/db/index_names.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/util/timer.h"
 #include "mongo/s/d_logic.h"
 
 namespace mongo {
 
+    // Number and time of plan cache hits turned back into query solutions.  Planning usually
+    // takes well under a millisecond, so these are kept in micros rather than as TimerStats.
+    static Counter64 planFromCacheNum;
+    static ServerStatusMetricField<Counter64> displayPlanFromCacheNum(
+                                                    "query.planning.fromCache.num",
+                                                    &planFromCacheNum );
+    static Counter64 planFromCacheMicros;
+    static ServerStatusMetricField<Counter64> displayPlanFromCacheMicros(
+                                                    "query.planning.fromCache.totalMicros",
+                                                    &planFromCacheMicros );
+
+    // Number and time of full planner runs.  Doesn't include the trial runs used to rank the
+    // resulting solutions.
+    static Counter64 planFullNum;
+    static ServerStatusMetricField<Counter64> displayPlanFullNum(
+                                                    "query.planning.full.num",
+                                                    &planFullNum );
+    static Counter64 planFullMicros;
+    static ServerStatusMetricField<Counter64> displayPlanFullMicros(
+                                                    "query.planning.full.totalMicros",
+                                                    &planFullMicros );
+
     // static
     void filterAllowedIndexEntries(const AllowedIndices& allowedIndices,
                                    std::vector<IndexEntry>* indexEntries) {
@@ -207,11 +232,14 @@ namespace mongo {
         // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
         boost::scoped_ptr<CachedSolution> cs(rawCS);
         QuerySolution *qs, *backupQs;
+        Timer planningTimer;
         Status status = QueryPlanner::planFromCache(*canonicalQuery,
                                                     plannerParams,
                                                     *cs,
                                                     &qs,
                                                     &backupQs);
+        planFromCacheNum.increment();
+        planFromCacheMicros.increment(planningTimer.micros());
         if (!status.isOK()) {
             return status;
         }
@@ -247,6 +275,7 @@ namespace mongo {
                                                      qs,
                                                      root,
                                                      ws);
+        cpr->setDecisionWorks(cs->decisionWorks);
 
         // If there's a backup solution, let the CachedPlanRunner know about it.
         if (NULL != backupQs) {
@@ -348,7 +377,10 @@ namespace mongo {
         auto_ptr<CanonicalQuery> canonicalQuery(rawCanonicalQuery);
 
         vector<QuerySolution*> solutions;
+        Timer planningTimer;
         Status status = QueryPlanner::plan(*canonicalQuery, plannerParams, &solutions);
+        planFullNum.increment();
+        planFullMicros.increment(planningTimer.micros());
         if (!status.isOK()) {
             return Status(ErrorCodes::BadValue,
                           "error processing query: " + canonicalQuery->toString() +
@@ -104,6 +104,7 @@ namespace mongo {
         : plannerData(entry.plannerData.size()),
           backupSoln(entry.backupSoln),
           key(key),
+          decisionWorks(0),
           query(entry.query.getOwned()),
           sort(entry.sort.getOwned()),
           projection(entry.projection.getOwned()) {
@@ -113,6 +114,11 @@ namespace mongo {
             verify(entry.plannerData[i]);
             plannerData[i] = entry.plannerData[i]->clone();
         }
+
+        // The winner's stats come first in the ranking decision.
+        if (NULL != entry.decision.get() && entry.decision->stats.size() > 0) {
+            decisionWorks = entry.decision->stats.vector()[0]->common.works;
+        }
     }
 
     CachedSolution::~CachedSolution() {
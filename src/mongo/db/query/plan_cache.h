@@ -186,6 +186,10 @@ namespace mongo {
         // Key used to provide feedback on the entry.
         PlanCacheKey key;
 
+        // Number of work() calls the winning plan took during the trial run that cached it.
+        // Zero if unknown.
+        size_t decisionWorks;
+
         // For debugging.
         std::string toString() const;
 
@@ -377,6 +377,28 @@ namespace {
         ASSERT_EQUALS(planCache.size(), 1U);
     }
 
+    TEST(PlanCacheTest, CachedSolutionHasDecisionWorks) {
+        PlanCache planCache;
+        auto_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+        QuerySolution qs;
+        qs.cacheData.reset(new SolutionCacheData());
+        qs.cacheData->tree.reset(new PlanCacheIndexTree());
+        std::vector<QuerySolution*> solns;
+        solns.push_back(&qs);
+        solns.push_back(&qs);
+
+        // The winning plan's stats come first in the decision.
+        PlanRankingDecision* decision = createDecision(2U);
+        decision->stats.vector()[0]->common.works = 7U;
+        decision->stats.vector()[1]->common.works = 3U;
+        ASSERT_OK(planCache.add(*cq, solns, decision));
+
+        CachedSolution* rawCS;
+        ASSERT_OK(planCache.get(*cq, &rawCS));
+        boost::scoped_ptr<CachedSolution> cs(rawCS);
+        ASSERT_EQUALS(cs->decisionWorks, 7U);
+    }
+
     TEST(PlanCacheTest, NotifyOfWriteOp) {
         PlanCache planCache;
         auto_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
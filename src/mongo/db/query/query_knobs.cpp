@@ -46,6 +46,8 @@ namespace mongo {
 
     MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheWriteOpsBetweenFlush, int, 1000);
 
+    MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheEvictionRatio, double, 10.0);
+
     MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerMaxIndexedSolutions, int, 64);
 
     MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnumerationMaxOrSolutions, int, 10);
@@ -58,4 +60,29 @@ namespace mongo {
 
     MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanOrChildrenIndependently, bool, true);
 
+    int internalQueryExecMaxBlockingSortBytes = 32 * 1024 * 1024;
+
+    namespace {
+        // The sort stage uses this as a size_t buffer limit, so it has to be positive.
+        class ExportedMaxBlockingSortBytesParameter : public ExportedServerParameter<int> {
+        public:
+            ExportedMaxBlockingSortBytesParameter() :
+                ExportedServerParameter<int>(ServerParameterSet::getGlobal(),
+                                             "internalQueryExecMaxBlockingSortBytes",
+                                             &internalQueryExecMaxBlockingSortBytes,
+                                             true,
+                                             true) {}
+
+            virtual Status validate(const int& potentialNewValue) {
+                if (potentialNewValue <= 0) {
+                    return Status(ErrorCodes::BadValue,
+                                  "internalQueryExecMaxBlockingSortBytes must be greater than 0");
+                }
+                return Status::OK();
+            }
+        } exportedMaxBlockingSortBytesParam;
+    }
+
+    MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecAllowExternalSort, bool, true);
+
 }  // namespace mongo
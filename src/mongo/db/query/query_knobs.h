@@ -69,6 +69,10 @@ namespace mongo {
     // How many write ops should we allow in a collection before tossing all cache entries?
     extern int internalQueryCacheWriteOpsBetweenFlush;
 
+    // If a cached plan needs more than this many times the works its trial run took before it
+    // produces its first result, evict the entry so that the next query replans.
+    extern double internalQueryCacheEvictionRatio;
+
     //
     // Planning and enumeration.
     //
@@ -85,4 +89,15 @@ namespace mongo {
     // Do we want to plan each child of the OR independently?
     extern bool internalQueryPlanOrChildrenIndependently;
 
+    //
+    // Query execution.
+    //
+
+    // How many bytes may a blocking sort buffer in memory?
+    extern int internalQueryExecMaxBlockingSortBytes;
+
+    // Does a blocking sort that outgrows internalQueryExecMaxBlockingSortBytes spill to disk
+    // rather than fail?
+    extern bool internalQueryExecAllowExternalSort;
+
 }  // namespace mongo
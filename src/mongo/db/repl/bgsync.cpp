@@ -35,6 +35,8 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/rs_sync.h"
 #include "mongo/db/repl/rs.h"
+#include "mongo/db/repl/sync_tail.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/base/counter.h"
 #include "mongo/db/stats/timer_stats.h"
@@ -45,6 +47,18 @@ namespace replset {
     int SleepToAllowBatchingMillis = 2;
     const int BatchIsSmallish = 40000; // bytes
 
+    // Have the sync source stream the oplog over an exhaust cursor instead of waiting for a
+    // getMore round trip per batch
+    MONGO_EXPORT_SERVER_PARAMETER(replOplogFetchStreaming, bool, true);
+    // Prefetch the pages an op will touch as soon as it is fetched, rather than only when the
+    // batch holding it is about to be applied
+    MONGO_EXPORT_SERVER_PARAMETER(replPrefetchOnFetch, bool, true);
+
+    const int fetchPrefetcherThreadCount = 4;
+    // past this many queued prefetches the pool has fallen behind the applier; ops it skips
+    // are still prefetched with their batch
+    const int maxPendingFetchPrefetches = 10000;
+
     MONGO_FP_DECLARE(rsBgSyncProduce);
 
     BackgroundSync* BackgroundSync::s_instance = 0;
@@ -76,6 +90,15 @@ namespace replset {
     static int bufferMaxSizeGauge = 256*1024*1024;
     static ServerStatusMetricField<int> displayBufferMaxSize( "repl.buffer.maxSizeBytes",
                                                                 &bufferMaxSizeGauge );
+    //The batches the sync source pushed over an exhaust cursor
+    static Counter64 streamedBatchesStats;
+    static ServerStatusMetricField<Counter64> displayStreamedBatches(
+                                                    "repl.network.streamedBatches",
+                                                    &streamedBatchesStats );
+    //The ops handed to the prefetcher as they were fetched
+    static Counter64 prefetchOnFetchStats;
+    static ServerStatusMetricField<Counter64> displayPrefetchOnFetch( "repl.preload.onFetch",
+                                                                &prefetchOnFetchStats );
 
 
     BackgroundSyncInterface::~BackgroundSyncInterface() {}
@@ -92,6 +115,7 @@ namespace replset {
                                        _appliedBuffer(true),
                                        _assumingPrimary(false),
                                        _currentSyncTarget(NULL),
+                                       _prefetcherPool(fetchPrefetcherThreadCount),
                                        _consumedOpTime(0, 0) {
     }
 
@@ -314,6 +338,11 @@ namespace replset {
             return;
         }
 
+        const bool streaming = replOplogFetchStreaming;
+        if (!startStreaming(r, lastOpTimeFetched, streaming)) {
+            return;
+        }
+
         while (!inShutdown()) {
             if (!r.moreInCurrentBatch()) {
                 // Check some things periodically
@@ -358,6 +387,9 @@ namespace replset {
                     r.more();
                 }
                 networkByteStats.increment(r.currentBatchMessageSize());
+                if (streaming && r.moreInCurrentBatch()) {
+                    streamedBatchesStats.increment();
+                }
 
                 if (!r.moreInCurrentBatch()) {
                     // If there is still no data from upstream, check a few more things
@@ -398,6 +430,7 @@ namespace replset {
             _buffer.push(o);
             bufferCountGauge.increment();
             bufferSizeGauge.increment(getSize(o));
+            prefetchAhead(o);
 
             {
                 boost::unique_lock<boost::mutex> lock(_mutex);
@@ -409,6 +442,37 @@ namespace replset {
         }
     }
 
+    bool BackgroundSync::startStreaming(OplogReader& r, const OpTime& lastOpTimeFetched,
+                                        bool streaming) {
+        if (!streaming) {
+            return true;
+        }
+
+        // isRollbackRequired() needed a cursor it could stop reading from, so the exhaust
+        // query starts over at the op we already have; the rest of the first batch is dropped.
+        r.resetCursor();
+        r.setTailingQueryOptions(r.getTailingQueryOptions() | QueryOption_Exhaust);
+        r.tailingQueryGTE(rsoplog, lastOpTimeFetched);
+        if (!r.haveCursor() || !r.more()) {
+            return false;
+        }
+
+        // if the sync source's oplog changed since the rollback check, go around again
+        BSONObj o = r.nextSafe();
+        boost::unique_lock<boost::mutex> lock(_mutex);
+        return o["ts"]._opTime() == _lastOpTimeFetched && o["h"].numberLong() == _lastH;
+    }
+
+    void BackgroundSync::prefetchAhead(const BSONObj& op) {
+        if (!replPrefetchOnFetch ||
+            _prefetcherPool.tasks_remaining() >= maxPendingFetchPrefetches) {
+            return;
+        }
+
+        prefetchOnFetchStats.increment();
+        _prefetcherPool.schedule(&SyncTail::prefetchFetchedOp, op);
+    }
+
     bool BackgroundSync::shouldChangeSyncTarget() {
         boost::unique_lock<boost::mutex> lock(_mutex);
 
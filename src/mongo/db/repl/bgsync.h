@@ -30,6 +30,7 @@
 
 #include <boost/thread/mutex.hpp>
 
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/queue.h"
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/rs.h"
@@ -91,6 +92,10 @@ namespace replset {
 
         const Member* _currentSyncTarget;
 
+        // touches the pages ops in _buffer will need while they wait to be applied, so that
+        // page faults overlap with the network rather than with batch application
+        threadpool::ThreadPool _prefetcherPool;
+
         // Notifier thread
 
         // used to wait until another op has been replicated
@@ -107,6 +112,12 @@ namespace replset {
         void _producerThread();
         // Adds elements to the list, up to maxSize.
         void produce();
+        // If 'streaming', reissues the tailing query as an exhaust cursor so the sync source
+        // streams batches without waiting for a getMore per batch.  Returns false if the reader
+        // has no usable cursor afterwards.
+        bool startStreaming(OplogReader& r, const OpTime& lastOpTimeFetched, bool streaming);
+        // Hands a fetched op to _prefetcherPool, unless it is already far behind
+        void prefetchAhead(const BSONObj& op);
         // Check if rollback is necessary
         bool isRollbackRequired(OplogReader& r);
         void getOplogReader(OplogReader& r);
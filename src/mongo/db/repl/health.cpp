@@ -40,6 +40,7 @@
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/rs.h"
 #include "mongo/db/repl/replset_commands.h"
+#include "mongo/db/repl/sync_tail.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/task.h"
 #include "mongo/util/goodies.h"
@@ -465,6 +466,17 @@ namespace mongo {
             b.append("syncingTo", syncTarget->fullName());
         }
         b.append("members", v);
+        if (myState == MemberState::RS_STARTUP2) {
+            BSONObjBuilder initialSync(b.subobjStart("initialSyncStatus"));
+            appendInitialSyncProgress(&initialSync);
+            initialSync.done();
+        }
+        if (!_self->config().arbiterOnly) {
+            // how evenly oplog application is spread over the writer threads
+            BSONArrayBuilder writers(b.subarrayStart("applyWriters"));
+            replset::SyncTail::appendWriterStats(&writers);
+            writers.done();
+        }
         if( replSetBlind )
             b.append("blind",true); // to avoid confusion if set...normally never set except for testing.
     }
@@ -201,24 +201,16 @@ namespace mongo {
     // on every logop call.
     static BufBuilder logopbufbuilder(8*1024);
     static const int OPLOG_VERSION = 2;
-    static void _logOpRS(const char *opstr, const char *ns, const char *logNS, const BSONObj& obj, BSONObj *o2, bool *bb, bool fromMigrate ) {
-        Lock::DBWrite lk1("local");
-
-        if ( strncmp(ns, "local.", 6) == 0 ) {
-            if ( strncmp(ns, "local.slaves", 12) == 0 )
-                resetSlaveCache();
-            return;
-        }
-
-        mutex::scoped_lock lk2(OpTime::m);
-
+    /**
+     * Writes one entry into local.oplog.rs.  The caller holds the lock on "local" and OpTime::m,
+     * has checked that this member may log, and has cached localOplogRSCollection.
+     */
+    static OpTime _writeOpRS(mutex::scoped_lock& lk2,
+                             const char *opstr, const char *ns, const BSONObj& obj,
+                             BSONObj *o2, bool *bb, bool fromMigrate ) {
         const OpTime ts = OpTime::now(lk2);
         long long hashNew;
         if( theReplSet ) {
-            if (!theReplSet->box.getState().primary()) {
-                log() << "replSet error : logOp() but not primary";
-                fassertFailed(17405);
-            }
             hashNew = (theReplSet->lastH * 131 + ts.asLL()) * 17 + theReplSet->selfId();
         }
         else {
@@ -246,17 +238,6 @@ namespace mongo {
             b.append("o2", *o2);
         BSONObj partial = b.done();
 
-        DEV verify( logNS == 0 ); // check this was never a master/slave master
-
-        if ( localOplogRSCollection == 0 ) {
-            Client::Context ctx(rsoplog, storageGlobalParams.dbpath);
-            localDB = ctx.db();
-            verify( localDB );
-            localOplogRSCollection = localDB->getCollection( rsoplog );
-            massert(13347, "local.oplog.rs missing. did you drop it? if so restart server", localOplogRSCollection);
-        }
-
-        Client::Context ctx(rsoplog, localDB);
         OplogDocWriter writer( partial, obj );
         checkOplogInsert( localOplogRSCollection->insertDocument( &writer, false ) );
 
@@ -277,9 +258,75 @@ namespace mongo {
             }
             theReplSet->lastOpTimeWritten = ts;
             theReplSet->lastH = hashNew;
+        }
+
+        return ts;
+    }
+
+    static void _cacheLocalOplogRS() {
+        if ( localOplogRSCollection == 0 ) {
+            Client::Context ctx(rsoplog, storageGlobalParams.dbpath);
+            localDB = ctx.db();
+            verify( localDB );
+            localOplogRSCollection = localDB->getCollection( rsoplog );
+            massert(13347, "local.oplog.rs missing. did you drop it? if so restart server", localOplogRSCollection);
+        }
+    }
+
+    static void _checkCanLogRS() {
+        if( theReplSet && !theReplSet->box.getState().primary() ) {
+            log() << "replSet error : logOp() but not primary";
+            fassertFailed(17405);
+        }
+    }
+
+    static void _logOpRS(const char *opstr, const char *ns, const char *logNS, const BSONObj& obj, BSONObj *o2, bool *bb, bool fromMigrate ) {
+        Lock::DBWrite lk1("local");
+
+        if ( strncmp(ns, "local.", 6) == 0 ) {
+            if ( strncmp(ns, "local.slaves", 12) == 0 )
+                resetSlaveCache();
+            return;
+        }
+
+        mutex::scoped_lock lk2(OpTime::m);
+        _checkCanLogRS();
+
+        DEV verify( logNS == 0 ); // check this was never a master/slave master
+
+        _cacheLocalOplogRS();
+        Client::Context ctx(rsoplog, localDB);
+        const OpTime ts = _writeOpRS(lk2, opstr, ns, obj, o2, bb, fromMigrate);
+        if( theReplSet ) {
             ctx.getClient()->setLastOp( ts );
         }
+    }
+
+    /**
+     * Logs a run of inserts into 'ns' while taking the lock on "local", OpTime::m and the oplog
+     * context once for the whole run.  The entries get consecutive timestamps.
+     */
+    static void _logInsertsRS(const char *ns, const std::vector<BSONObj>& docs) {
+        Lock::DBWrite lk1("local");
+
+        if ( strncmp(ns, "local.", 6) == 0 ) {
+            if ( strncmp(ns, "local.slaves", 12) == 0 )
+                resetSlaveCache();
+            return;
+        }
+
+        mutex::scoped_lock lk2(OpTime::m);
+        _checkCanLogRS();
 
+        _cacheLocalOplogRS();
+        Client::Context ctx(rsoplog, localDB);
+        OpTime ts;
+        for ( std::vector<BSONObj>::const_iterator it = docs.begin(); it != docs.end(); ++it ) {
+            ts = _writeOpRS(lk2, "i", ns, *it, 0, 0, false);
+        }
+        if( theReplSet ) {
+            ctx.getClient()->setLastOp( ts );
+        }
     }
 
     static void _logOpOld(const char *opstr, const char *ns, const char *logNS, const BSONObj& obj, BSONObj *o2, bool *bb, bool fromMigrate ) {
@@ -355,6 +402,23 @@ namespace mongo {
         _logOpRS("n", "", 0, obj, 0, 0, false);
     }
 
+    // everything besides the oplog that has to hear about a write
+    static void _logOpObservers(const char* opstr,
+                                const char* ns,
+                                const BSONObj& obj,
+                                BSONObj* patt,
+                                bool* b,
+                                bool fromMigrate,
+                                const BSONObj* fullObj) {
+        logOpForSharding(opstr, ns, obj, patt, fullObj, fromMigrate);
+        logOpForDbHash(opstr, ns, obj, patt, fullObj, fromMigrate);
+        getGlobalAuthorizationManager()->logOp(opstr, ns, obj, patt, b);
+
+        if ( strstr( ns, ".system.js" ) ) {
+            Scope::storedFuncMod(); // this is terrible
+        }
+    }
+
     /*@ @param opstr:
           c userCreateNS
           i insert
@@ -373,14 +437,24 @@ namespace mongo {
             _logOp(opstr, ns, 0, obj, patt, b, fromMigrate);
         }
 
-        logOpForSharding(opstr, ns, obj, patt, fullObj, fromMigrate);
-        logOpForDbHash(opstr, ns, obj, patt, fullObj, fromMigrate);
-        getGlobalAuthorizationManager()->logOp(opstr, ns, obj, patt, b);
+        _logOpObservers(opstr, ns, obj, patt, b, fromMigrate, fullObj);
+    }
 
-        if ( strstr( ns, ".system.js" ) ) {
-            Scope::storedFuncMod(); // this is terrible
+    void logInserts(const char* ns, const std::vector<BSONObj>& docs) {
+        if ( replSettings.master ) {
+            if ( _logOp == _logOpRS ) {
+                _logInsertsRS(ns, docs);
+            }
+            else {
+                for ( std::vector<BSONObj>::const_iterator it = docs.begin(); it != docs.end(); ++it ) {
+                    _logOp("i", ns, 0, *it, 0, 0, false);
+                }
+            }
         }
 
+        for ( std::vector<BSONObj>::const_iterator it = docs.begin(); it != docs.end(); ++it ) {
+            _logOpObservers("i", ns, *it, 0, 0, false, 0);
+        }
     }
 
     void createOplog() {
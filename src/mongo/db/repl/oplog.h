@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace mongo {
 
     class BSONObj;
@@ -70,6 +72,13 @@ namespace mongo {
                 BSONObj *patt = NULL, bool *b = NULL, bool fromMigrate = false,
                 const BSONObj* fullObj = NULL );
 
+    /**
+     * Log the insert of each of 'docs' into 'ns', in order, as logOp("i", ...) would.  On a
+     * replica set primary the entries are written in one pass over the oplog, with consecutive
+     * timestamps.
+     */
+    void logInserts(const char* ns, const std::vector<BSONObj>& docs);
+
     // Log an empty no-op operation to the local oplog
     void logKeepalive();
 
@@ -291,8 +291,9 @@ namespace mongo {
         friend class Consensus;
 
     private:
-        bool _syncDoInitialSync_clone(Cloner &cloner, const char *master,
-                                      const list<string>& dbs, bool dataPass);
+        bool _syncDoInitialSync_clone(const char *master, const list<string>& dbs,
+                                      bool dataPass);
+        static void appendInitialSyncProgress(BSONObjBuilder* b); // for replSetGetStatus
         bool _syncDoInitialSync_applyToHead( replset::SyncTail& syncer, OplogReader* r ,
                                              const Member* source, const BSONObj& lastOp,
                                              BSONObj& minValidOut);
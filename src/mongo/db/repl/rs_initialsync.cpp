@@ -30,6 +30,8 @@
 
 #include "mongo/db/repl/rs.h"
 
+#include <boost/thread/thread.hpp>
+
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authorization_manager_global.h"
 #include "mongo/db/client.h"
@@ -42,6 +44,7 @@
 #include "mongo/bson/optime.h"
 #include "mongo/db/repl/repl_settings.h"  // replSettings
 #include "mongo/db/repl/initial_sync.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/structure/catalog/namespace_details.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -52,6 +55,258 @@ namespace mongo {
 
     void dropAllDatabasesExceptLocal();
 
+    // Databases initial sync clones at the same time, each on its own thread and connection.
+    MONGO_EXPORT_SERVER_PARAMETER(initialSyncCloneThreads, int, 4);
+
+    namespace {
+
+        /**
+         * Progress of the clone phases of initial sync, reported by replSetGetStatus.  Finished
+         * collections are only counted; the ones being copied are listed with their throughput.
+         */
+        class InitialSyncProgress : public CloneProgressListener {
+        public:
+            InitialSyncProgress() : _mutex("InitialSyncProgress") {
+                reset("none", 0);
+            }
+
+            void reset(const string& pass, int databases) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                _pass = pass;
+                _databasesTotal = databases;
+                _databasesDone = 0;
+                _collectionsDone = 0;
+                _docs = 0;
+                _bytes = 0;
+                _activeDatabases.clear();
+                _active.clear();
+            }
+
+            void databaseStarted(const string& db) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                _activeDatabases.insert(db);
+            }
+
+            void databaseDone(const string& db) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                _activeDatabases.erase(db);
+                _databasesDone++;
+            }
+
+            /** What the thread coordinating the clone reports as this member's heartbeat message */
+            string heartbeatMessage() {
+                SimpleMutex::scoped_lock lk(_mutex);
+                str::stream msg;
+                msg << (_pass == "data" ? "initial sync cloning db: "
+                                        : "initial sync cloning indexes for : ");
+                for (set<string>::const_iterator it = _activeDatabases.begin();
+                     it != _activeDatabases.end();
+                     ++it) {
+                    msg << (it == _activeDatabases.begin() ? "" : ", ") << *it;
+                }
+                return msg;
+            }
+
+            virtual void collectionStarted(const string& ns) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                _active[ns] = CollectionProgress(curTimeMillis64());
+            }
+
+            virtual void documentsCloned(const string& ns, long long docs, long long bytes) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                CollectionProgress& progress = _active[ns];
+                progress.docs += docs;
+                progress.bytes += bytes;
+                _docs += docs;
+                _bytes += bytes;
+            }
+
+            virtual void collectionFinished(const string& ns) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                _active.erase(ns);
+                _collectionsDone++;
+            }
+
+            void append(BSONObjBuilder* b) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                b->append("pass", _pass);
+                b->append("databasesCloned", _databasesDone);
+                b->append("databasesTotal", _databasesTotal);
+                b->append("collectionsCloned", _collectionsDone);
+                b->append("documentsCloned", _docs);
+                b->append("bytesCloned", _bytes);
+
+                const unsigned long long now = curTimeMillis64();
+                BSONArrayBuilder active(b->subarrayStart("activeCollections"));
+                for (map<string, CollectionProgress>::const_iterator it = _active.begin();
+                     it != _active.end();
+                     ++it) {
+                    const CollectionProgress& progress = it->second;
+                    const long long elapsedMillis = now - progress.startMillis;
+
+                    BSONObjBuilder bb(active.subobjStart());
+                    bb.append("ns", it->first);
+                    bb.append("documents", progress.docs);
+                    bb.append("bytes", progress.bytes);
+                    bb.append("elapsedMillis", elapsedMillis);
+                    bb.append("documentsPerSec",
+                              elapsedMillis ? progress.docs * 1000 / elapsedMillis : 0LL);
+                    bb.done();
+                }
+                active.done();
+            }
+
+        private:
+            struct CollectionProgress {
+                CollectionProgress(unsigned long long start = 0)
+                    : startMillis(start), docs(0), bytes(0) { }
+
+                unsigned long long startMillis;
+                long long docs;
+                long long bytes;
+            };
+
+            SimpleMutex _mutex;
+            string _pass;
+            int _databasesTotal;
+            int _databasesDone;
+            int _collectionsDone;
+            long long _docs;
+            long long _bytes;
+            set<string> _activeDatabases;
+            map<string, CollectionProgress> _active;
+        };
+
+        InitialSyncProgress initialSyncProgress;
+
+        /**
+         * Hands out the databases still to be cloned to the cloning threads, and holds on to the
+         * first failure so that the others can stop early and the caller can report it.
+         */
+        class CloneQueue {
+        public:
+            explicit CloneQueue(const list<string>& dbs)
+                : _mutex("initialSyncCloneQueue"),
+                  _remaining(dbs.begin(), dbs.end()),
+                  _failed(false),
+                  _exceptionCode(0) { }
+
+            bool next(string* db) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                if (_failed || _remaining.empty())
+                    return false;
+                *db = _remaining.front();
+                _remaining.pop_front();
+                return true;
+            }
+
+            void fail(const string& msg) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                if (!_failed)
+                    _failureMsg = msg;
+                _failed = true;
+            }
+
+            void failWithException(int code, const string& msg) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                if (!_failed || !_exceptionCode) {
+                    _exceptionCode = code;
+                    _exceptionMsg = msg;
+                }
+                _failed = true;
+            }
+
+            bool failed() const { return _failed; }
+
+            /** Why the clone failed, if it failed without an exception */
+            const string& failureMessage() const { return _failureMsg; }
+
+            void rethrowIfException() const {
+                if (_exceptionCode)
+                    uasserted(_exceptionCode, _exceptionMsg);
+            }
+
+        private:
+            SimpleMutex _mutex;
+            deque<string> _remaining;
+            bool _failed;
+            string _failureMsg;
+            int _exceptionCode;
+            string _exceptionMsg;
+        };
+
+        /**
+         * Clones databases off 'queue' until it is empty or something fails.  Progress goes to
+         * initialSyncProgress.  The heartbeat message is only set from the thread coordinating
+         * the clone, so cloning threads pass false for 'setHeartbeatMessage'.
+         */
+        void cloneDatabases(const string& master, bool dataPass, CloneQueue* queue,
+                            bool setHeartbeatMessage) {
+            Cloner cloner;
+            cloner.setProgressListener(&initialSyncProgress);
+
+            string db;
+            while (queue->next(&db)) {
+                initialSyncProgress.databaseStarted(db);
+                if (setHeartbeatMessage)
+                    theReplSet->sethbmsg(initialSyncProgress.heartbeatMessage(), 0);
+
+                Client::WriteContext ctx(db);
+
+                string err;
+                int errCode;
+                CloneOptions options;
+                options.fromDB = db;
+                options.logForRepl = false;
+                options.slaveOk = true;
+                options.useReplAuth = true;
+                options.snapshot = false;
+                options.mayYield = true;
+                options.mayBeInterrupted = false;
+                options.syncData = dataPass;
+                options.syncIndexes = ! dataPass;
+
+                if (!cloner.go(ctx.ctx(), master, options, NULL, err, &errCode)) {
+                    queue->fail(str::stream() << "initial sync: error while "
+                                              << (dataPass ? "cloning " : "indexing ") << db
+                                              << ".  " << (err.empty() ? "" : err + ".  ")
+                                              << "sleeping 5 minutes");
+                    return;
+                }
+
+                initialSyncProgress.databaseDone(db);
+            }
+        }
+
+        void cloneDatabasesThread(const string& master, bool dataPass, CloneQueue* queue,
+                                  int threadNum) {
+            string threadName = str::stream() << "initial sync cloner " << threadNum;
+            Client::initThread(threadName.c_str());
+            replLocalAuth();
+
+            try {
+                cloneDatabases(master, dataPass, queue, false);
+            }
+            catch (const DBException& e) {
+                log() << "replSet " << threadName << " caught exception: " << e.toString()
+                      << rsLog;
+                queue->failWithException(e.getCode(), e.what());
+            }
+            catch (const std::exception& e) {
+                log() << "replSet " << threadName << " caught exception: " << e.what() << rsLog;
+                queue->failWithException(17466, str::stream() << "initial sync clone error: "
+                                                              << e.what());
+            }
+            catch (...) {
+                log() << "replSet " << threadName << " caught unknown exception" << rsLog;
+                queue->failWithException(17466, "initial sync clone error: unknown exception");
+            }
+
+            cc().shutdown();
+        }
+
+    }  // namespace
+
     // add try/catch with sleep
 
     void isyncassert(const string& msg, bool expr) {
@@ -83,44 +338,61 @@ namespace mongo {
         fassert( 16233, failedAttempts < maxFailedAttempts);
     }
 
-    bool ReplSetImpl::_syncDoInitialSync_clone(Cloner& cloner, const char *master,
+    bool ReplSetImpl::_syncDoInitialSync_clone(const char *master,
                                                const list<string>& dbs, bool dataPass) {
 
+        list<string> toClone;
         for( list<string>::const_iterator i = dbs.begin(); i != dbs.end(); i++ ) {
-            string db = *i;
-            if( db == "local" ) 
-                continue;
-            
-            if ( dataPass )
-                sethbmsg( str::stream() << "initial sync cloning db: " << db , 0);
-            else
-                sethbmsg( str::stream() << "initial sync cloning indexes for : " << db , 0);
-
-            Client::WriteContext ctx(db);
-
-            string err;
-            int errCode;
-            CloneOptions options;
-            options.fromDB = db;
-            options.logForRepl = false;
-            options.slaveOk = true;
-            options.useReplAuth = true;
-            options.snapshot = false;
-            options.mayYield = true;
-            options.mayBeInterrupted = false;
-            options.syncData = dataPass;
-            options.syncIndexes = ! dataPass;
-
-            if (!cloner.go(ctx.ctx(), master, options, NULL, err, &errCode)) {
-                sethbmsg(str::stream() << "initial sync: error while "
-                                       << (dataPass ? "cloning " : "indexing ") << db
-                                       << ".  " << (err.empty() ? "" : err + ".  ")
-                                       << "sleeping 5 minutes" ,0);
-                return false;
+            if( *i != "local" )
+                toClone.push_back(*i);
+        }
+
+        initialSyncProgress.reset(dataPass ? "data" : "indexes", toClone.size());
+        CloneQueue queue(toClone);
+
+        const size_t threads = std::min(toClone.size(),
+                                        static_cast<size_t>(std::max(initialSyncCloneThreads, 1)));
+        if ( threads <= 1 ) {
+            cloneDatabases(master, dataPass, &queue, true);
+        }
+        else {
+            // Each database is cloned by one thread under its own database lock, so several
+            // databases stream in at once over separate connections.  This thread waits for
+            // them and keeps the heartbeat message up to date with what they are copying.
+            vector<boost::shared_ptr<boost::thread> > cloners;
+            try {
+                for( size_t i = 0; i < threads; i++ ) {
+                    cloners.push_back(boost::shared_ptr<boost::thread>(new boost::thread(
+                            boost::bind(&cloneDatabasesThread, string(master), dataPass,
+                                        &queue, static_cast<int>(i)))));
+                }
+            }
+            catch (...) {
+                queue.fail("initial sync: couldn't start cloning threads");
+                for( size_t i = 0; i < cloners.size(); i++ ) {
+                    cloners[i]->join();
+                }
+                throw;
             }
+
+            for( size_t i = 0; i < cloners.size(); i++ ) {
+                while( !cloners[i]->timed_join(boost::posix_time::seconds(1)) ) {
+                    sethbmsg(initialSyncProgress.heartbeatMessage(), 0);
+                }
+            }
+
+            // An exception goes to syncDoInitialSync()'s retry loop, just as when cloning
+            // serially.
+            queue.rethrowIfException();
         }
 
-        return true;
+        if ( queue.failed() )
+            sethbmsg(queue.failureMessage(), 0);
+        return !queue.failed();
+    }
+
+    void ReplSetImpl::appendInitialSyncProgress(BSONObjBuilder* b) {
+        initialSyncProgress.append(b);
     }
 
     void _logOpObjRS(const BSONObj& op);
@@ -407,8 +679,7 @@ namespace mongo {
 
             list<string> dbs = r.conn()->getDatabaseNames();
 
-            Cloner cloner;
-            if (!_syncDoInitialSync_clone(cloner, sourceHostname.c_str(), dbs, true)) {
+            if (!_syncDoInitialSync_clone(sourceHostname.c_str(), dbs, true)) {
                 veto(source->fullName(), 600);
                 sleepsecs(300);
                 return;
@@ -435,7 +706,7 @@ namespace mongo {
             lastOp = minValid;
 
             sethbmsg("initial sync building indexes",0);
-            if (!_syncDoInitialSync_clone(cloner, sourceHostname.c_str(), dbs, false)) {
+            if (!_syncDoInitialSync_clone(sourceHostname.c_str(), dbs, false)) {
                 veto(source->fullName(), 600);
                 sleepsecs(300);
                 return;
@@ -29,6 +29,8 @@
 
 #include "mongo/pch.h"
 
+#include <boost/thread/thread.hpp>
+
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authorization_manager_global.h"
 #include "mongo/db/client.h"
@@ -41,6 +43,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/rs.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/structure/catalog/namespace_details.h"
 
 /* Scenarios
@@ -334,37 +337,197 @@ namespace mongo {
         bson::bo goodVersionOfObject;
     };
 
+    // Connections to the sync source used to refetch documents, and how many documents of one
+    // collection each query asks for.
+    MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchThreads, int, 4);
+    MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchBatchSize, int, 1000);
+
+    namespace {
+
+        /** Documents of one collection refetched together with an $in on _id. */
+        struct RefetchBatch {
+            string ns;
+            vector<DocID> ids;
+            BSONObj query;
+            // parallel to ids; empty where the sync source no longer has the document
+            vector<bo> goodVersions;
+        };
+
+        /** Splits the documents to refetch into batches, in toRefetch's order. */
+        void makeRefetchBatches(const set<DocID>& toRefetch, vector<RefetchBatch>* batches) {
+            const size_t batchSize = std::max(1, rollbackRefetchBatchSize);
+            for( set<DocID>::const_iterator i = toRefetch.begin(); i != toRefetch.end(); ) {
+                RefetchBatch batch;
+                batch.ns = i->ns;
+                while( i != toRefetch.end() && batch.ns == i->ns &&
+                       batch.ids.size() < batchSize ) {
+                    verify( !i->_id.eoo() );
+                    // a regex _id would match other documents under $in, so look it up alone
+                    // the way it always was
+                    if( i->_id.type() == RegEx ) {
+                        if( batch.ids.empty() ) {
+                            batch.ids.push_back(*i);
+                            ++i;
+                        }
+                        break;
+                    }
+                    batch.ids.push_back(*i);
+                    ++i;
+                }
+
+                if( batch.ids.size() == 1 ) {
+                    batch.query = batch.ids[0]._id.wrap();
+                }
+                else {
+                    BSONObjBuilder q;
+                    BSONObjBuilder idClause(q.subobjStart("_id"));
+                    BSONArrayBuilder in(idClause.subarrayStart("$in"));
+                    for( vector<DocID>::const_iterator j = batch.ids.begin(); j != batch.ids.end(); ++j ) {
+                        in.append(j->_id);
+                    }
+                    in.done();
+                    idClause.done();
+                    batch.query = q.obj();
+                }
+                batches->push_back(batch);
+            }
+        }
+
+        /**
+         * Runs refetch batches over several connections to the sync source.  Rollback holds the
+         * write lock the whole time, so the fetching threads only ever talk to the network.
+         */
+        class Refetcher {
+        public:
+            Refetcher(const string& host, vector<RefetchBatch>* batches)
+                : _mutex("rollbackRefetcher"),
+                  _host(host),
+                  _batches(batches),
+                  _next(0),
+                  _totSize(0),
+                  _exceptionCode(0) { }
+
+            /** Returns once every batch is fetched; throws what the first failed fetch threw. */
+            void run() {
+                size_t threads = std::max(1, rollbackRefetchThreads);
+                threads = std::min(threads, _batches->size());
+
+                boost::thread_group fetchers;
+                try {
+                    for( size_t i = 0; i < threads; i++ ) {
+                        fetchers.create_thread(boost::bind(&Refetcher::fetchThread, this));
+                    }
+                }
+                catch (...) {
+                    fail(17462, "rollback couldn't start refetch threads");
+                    fetchers.join_all();
+                    throw;
+                }
+                fetchers.join_all();
+
+                if( _exceptionCode )
+                    uasserted(_exceptionCode, _exceptionMsg);
+            }
+
+            size_t fetched() const { return _next; }
+
+        private:
+            RefetchBatch* next() {
+                SimpleMutex::scoped_lock lk(_mutex);
+                if( _exceptionCode || _next == _batches->size() )
+                    return NULL;
+                return &(*_batches)[_next++];
+            }
+
+            void fail(int code, const string& msg) {
+                SimpleMutex::scoped_lock lk(_mutex);
+                if( !_exceptionCode ) {
+                    _exceptionCode = code;
+                    _exceptionMsg = msg;
+                }
+            }
+
+            void fetchThread() {
+                try {
+                    OplogReader r;
+                    uassert(17463, str::stream() << "rollback can't connect to " << _host,
+                            r.connect(_host));
+                    while( RefetchBatch* batch = next() ) {
+                        fetch(r.conn(), batch);
+                    }
+                }
+                catch (const DBException& e) {
+                    fail(e.getCode(), e.what());
+                }
+                catch (const std::exception& e) {
+                    fail(17464, str::stream() << "rollback refetch error: " << e.what());
+                }
+            }
+
+            void fetch(DBClientConnection* conn, RefetchBatch* batch) {
+                auto_ptr<DBClientCursor> cursor = conn->query(batch->ns, batch->query, 0, 0,
+                                                              NULL, QueryOption_SlaveOk);
+                uassert(17465, str::stream() << "rollback refetch query failed on " << batch->ns,
+                        cursor.get());
+
+                vector<bo> docs;
+                while( cursor->more() ) {
+                    bo doc = cursor->nextSafe();
+                    {
+                        // counted per document across all the fetching threads, so memory stops
+                        // growing as soon as the limit is reached rather than after a batch
+                        SimpleMutex::scoped_lock lk(_mutex);
+                        _totSize += doc.objsize();
+                        uassert( 13410, "replSet too much data to roll back", _totSize < 300 * 1024 * 1024 );
+                    }
+                    docs.push_back(doc.getOwned());
+                }
+
+                batch->goodVersions.resize(batch->ids.size());
+                if( batch->ids.size() == 1 ) {
+                    if( !docs.empty() )
+                        batch->goodVersions[0] = docs[0];
+                    return;
+                }
+
+                map<BSONObj, bo, BSONObjCmp> byId;
+                for( vector<bo>::const_iterator i = docs.begin(); i != docs.end(); ++i ) {
+                    byId[(*i)["_id"].wrap()] = *i;
+                }
+                for( size_t i = 0; i < batch->ids.size(); i++ ) {
+                    map<BSONObj, bo, BSONObjCmp>::const_iterator it =
+                        byId.find(batch->ids[i]._id.wrap());
+                    if( it != byId.end() )
+                        batch->goodVersions[i] = it->second;
+                }
+            }
+
+            SimpleMutex _mutex;
+            const string _host;
+            vector<RefetchBatch>* _batches;
+            size_t _next;
+            unsigned long long _totSize;
+            int _exceptionCode;
+            string _exceptionMsg;
+        };
+
+    } // namespace
+
     void ReplSetImpl::syncFixUp(HowToFixUp& h, OplogReader& r) {
         DBClientConnection *them = r.conn();
 
         // fetch all first so we needn't handle interruption in a fancy way
 
-        unsigned long long totSize = 0;
-
         list< pair<DocID,bo> > goodVersions;
 
         bo newMinValid;
 
         /* fetch all the goodVersions of each document from current primary */
-        DocID d;
-        unsigned long long n = 0;
+        vector<RefetchBatch> batches;
+        makeRefetchBatches(h.toRefetch, &batches);
+        Refetcher refetcher(them->getServerAddress(), &batches);
         try {
-            for( set<DocID>::iterator i = h.toRefetch.begin(); i != h.toRefetch.end(); i++ ) {
-                d = *i;
-
-                verify( !d._id.eoo() );
-
-                {
-                    /* TODO : slow.  lots of round trips. */
-                    n++;
-                    bo good= them->findOne(d.ns, d._id.wrap(), NULL, QueryOption_SlaveOk).getOwned();
-                    totSize += good.objsize();
-                    uassert( 13410, "replSet too much data to roll back", totSize < 300 * 1024 * 1024 );
-
-                    // note good might be eoo, indicating we should delete it
-                    goodVersions.push_back(pair<DocID,bo>(d,good));
-                }
-            }
+            refetcher.run();
             newMinValid = r.getLastOp(rsoplog);
             if( newMinValid.isEmpty() ) {
                 sethbmsg("rollback error newMinValid empty?");
@@ -373,8 +536,16 @@ namespace mongo {
         }
         catch(DBException& e) {
             sethbmsg(str::stream() << "rollback re-get objects: " << e.toString(),0);
-            log() << "rollback couldn't re-get ns:" << d.ns << " _id:" << d._id << ' ' << n << '/' << h.toRefetch.size() << rsLog;
-            throw e;
+            log() << "rollback couldn't re-get objects, batches started: " << refetcher.fetched()
+                  << '/' << batches.size() << rsLog;
+            throw;
+        }
+
+        for( vector<RefetchBatch>::const_iterator i = batches.begin(); i != batches.end(); ++i ) {
+            for( size_t j = 0; j < i->ids.size(); j++ ) {
+                // note the good version might be empty, indicating we should delete it
+                goodVersions.push_back(pair<DocID,bo>(i->ids[j], i->goodVersions[j]));
+            }
         }
 
         MemoryMappedFile::flushAll(true);
@@ -33,14 +33,17 @@
 #include "third_party/murmurhash3/MurmurHash3.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/commands/fsync.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/prefetch.h"
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/oplog.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace replset {
@@ -53,11 +56,37 @@ namespace replset {
 
     MONGO_FP_DECLARE(rsSyncApplyStop);
 
-    // Number and time of each ApplyOps worker pool round
+    // Most ops applied in one round, that is under one hold of the lock that keeps readers out.
+    // Larger batches take several rounds with reads let in between; 0 applies a batch in one.
+    MONGO_EXPORT_SERVER_PARAMETER(replBatchApplyRoundOps, int, 1000);
+
+    // Number and time of each batch applied
     static TimerStats applyBatchStats;
     static ServerStatusMetricField<TimerStats> displayOpBatchesApplied(
                                                     "repl.apply.batches",
                                                     &applyBatchStats );
+    // Number of rounds batches were applied in, each under its own hold of the batch writer lock
+    static Counter64 applyRoundsStats;
+    static ServerStatusMetricField<Counter64> displayApplyRounds( "repl.apply.rounds",
+                                                                  &applyRoundsStats );
+    namespace {
+        // Apply counters for one of the writer vectors a batch is partitioned into
+        struct WriterStats {
+            AtomicInt64 batches;
+            AtomicInt64 ops;
+            AtomicInt64 micros;
+        };
+
+        // Number of writer vectors each batch is partitioned into, one per writer pool thread.
+        // writerStats and the writer vectors are both sized from this.
+        size_t numWriterVectors() {
+            return ReplSetImpl::replWriterThreadCount;
+        }
+
+        // one per writer vector, see fillWriterVectors()
+        WriterStats* writerStats = new WriterStats[numWriterVectors()];
+    }
+
     void initializePrefetchThread() {
         if (!ClientBasic::getCurrent()) {
             Client::initThread("repl prefetch worker");
@@ -137,6 +166,31 @@ namespace replset {
         }
     }
 
+    void SyncTail::prefetchFetchedOp(const BSONObj& op) {
+        initializePrefetchThread();
+
+        const char *ns = op.getStringField("ns");
+        if (ns && (ns[0] != '\0')) {
+            try {
+                // Ops are prefetched as they are fetched, in no order relative to the batches
+                // being applied, so this must never open a database: the op may be for one
+                // that an op already applied has dropped, and opening it would create it again.
+                Lock::DBRead lk(ns);
+                Database* db = dbHolder().get(ns, storageGlobalParams.dbpath);
+                if (db) {
+                    prefetchPagesForReplicatedOp(db, op);
+                }
+            }
+            catch (const DBException& e) {
+                LOG(2) << "ignoring exception in prefetchFetchedOp(): " << e.what() << endl;
+            }
+            catch (const std::exception& e) {
+                log() << "Unhandled std::exception in prefetchFetchedOp(): " << e.what() << endl;
+                fassertFailed(17468);
+            }
+        }
+    }
+
     // Doles out all the work to the reader pool threads and waits for them to complete
     void SyncTail::prefetchOps(const std::deque<BSONObj>& ops) {
         threadpool::ThreadPool& prefetcherPool = theReplSet->getPrefetchPool();
@@ -148,16 +202,42 @@ namespace replset {
         prefetcherPool.join();
     }
     
+    void SyncTail::applyWriterVector(MultiSyncApplyFunc applyFunc,
+                                     const std::vector<BSONObj>& ops,
+                                     SyncTail* st,
+                                     size_t writerId) {
+        dassert(writerId < numWriterVectors());
+        Timer timer;
+        applyFunc(ops, st);
+
+        WriterStats& stats = writerStats[writerId];
+        stats.batches.fetchAndAdd(1);
+        stats.ops.fetchAndAdd(ops.size());
+        stats.micros.fetchAndAdd(timer.micros());
+    }
+
+    void SyncTail::appendWriterStats(BSONArrayBuilder* b) {
+        for (size_t i = 0; i < numWriterVectors(); i++) {
+            const WriterStats& stats = writerStats[i];
+            BSONObjBuilder bb(b->subobjStart());
+            bb.append("batches", stats.batches.load());
+            bb.append("ops", stats.ops.load());
+            bb.append("applyMicros", stats.micros.load());
+            bb.done();
+        }
+    }
+
     // Doles out all the work to the writer pool threads and waits for them to complete
     void SyncTail::applyOps(const std::vector< std::vector<BSONObj> >& writerVectors, 
                                      MultiSyncApplyFunc applyFunc) {
         ThreadPool& writerPool = theReplSet->getWriterPool();
-        TimerHolder timer(&applyBatchStats);
-        for (std::vector< std::vector<BSONObj> >::const_iterator it = writerVectors.begin();
-             it != writerVectors.end();
-             ++it) {
-            if (!it->empty()) {
-                writerPool.schedule(applyFunc, boost::cref(*it), this);
+        for (size_t i = 0; i < writerVectors.size(); i++) {
+            if (!writerVectors[i].empty()) {
+                writerPool.schedule(&SyncTail::applyWriterVector,
+                                    applyFunc,
+                                    boost::cref(writerVectors[i]),
+                                    this,
+                                    i);
             }
         }
         writerPool.join();
@@ -169,26 +249,46 @@ namespace replset {
         // Use a ThreadPool to prefetch all the operations in a batch.
         prefetchOps(ops);
         
-        std::vector< std::vector<BSONObj> > writerVectors(theReplSet->replWriterThreadCount);
-        fillWriterVectors(ops, &writerVectors);
         LOG(2) << "replication batch size is " << ops.size() << endl;
-        // We must grab this because we're going to grab write locks later.
-        // We hold this mutex the entire time we're writing; it doesn't matter
-        // because all readers are blocked anyway.
-        SimpleMutex::scoped_lock fsynclk(filesLockedFsync);
+        TimerHolder timer(&applyBatchStats);
 
-        // stop all readers until we're done
-        Lock::ParallelBatchWriterMode pbwm;
+        // Readers can't run while a round is applied.  Every round ends on an op boundary and
+        // rounds go in oplog order, so between rounds the data is in a state the primary has
+        // been in, and readers are let in there rather than waiting out the whole batch.
+        const size_t roundOps = replBatchApplyRoundOps > 0 ?
+            static_cast<size_t>(replBatchApplyRoundOps) : ops.size();
+        std::deque<BSONObj>::const_iterator begin = ops.begin();
+        while (begin != ops.end()) {
+            const size_t n = std::min(roundOps, static_cast<size_t>(ops.end() - begin));
+            std::deque<BSONObj>::const_iterator end = begin + n;
+
+            std::vector< std::vector<BSONObj> > writerVectors(numWriterVectors());
+            fillWriterVectors(begin, end, &writerVectors);
+            {
+                // We must grab this because we're going to grab write locks later.
+                // We hold this mutex the entire time we're writing; it doesn't matter
+                // because all readers are blocked anyway.
+                SimpleMutex::scoped_lock fsynclk(filesLockedFsync);
+
+                // stop all readers until this round is done
+                Lock::ParallelBatchWriterMode pbwm;
+
+                applyOps(writerVectors, applyFunc);
+            }
+            applyRoundsStats.increment();
 
-        applyOps(writerVectors, applyFunc);
+            begin = end;
+            if (begin != ops.end()) {
+                yieldOrSleepFor1Microsecond();
+            }
+        }
     }
 
 
-    void SyncTail::fillWriterVectors(const std::deque<BSONObj>& ops, 
-                                              std::vector< std::vector<BSONObj> >* writerVectors) {
-        for (std::deque<BSONObj>::const_iterator it = ops.begin();
-             it != ops.end();
-             ++it) {
+    void SyncTail::fillWriterVectors(std::deque<BSONObj>::const_iterator begin,
+                                     std::deque<BSONObj>::const_iterator end,
+                                     std::vector< std::vector<BSONObj> >* writerVectors) {
+        for (std::deque<BSONObj>::const_iterator it = begin; it != end; ++it) {
             const BSONElement e = it->getField("ns");
             verify(e.type() == String);
             const char* ns = e.valuestr();
@@ -96,6 +96,19 @@ namespace replset {
         // stop waiting and apply the queue we have.  Only returns false if !ops.empty().
         bool tryPopAndWaitForMore(OpQueue* ops);
         
+        /**
+         * Appends, for each writer vector a batch is partitioned into, how many batches and ops
+         * it applied and the time spent applying them.  For replSetGetStatus.
+         */
+        static void appendWriterStats(BSONArrayBuilder* b);
+
+        // Used by the thread pool readers to prefetch an op
+        static void prefetchOp(const BSONObj& op);
+
+        // Used by the background sync thread's pool to prefetch an op as soon as it is fetched.
+        // Only prefetches for databases that are already open.
+        static void prefetchFetchedOp(const BSONObj& op);
+
         // After ops have been written to db, call this
         // to update local oplog.rs, as well as notify the primary
         // that we have applied the ops.
@@ -121,14 +134,19 @@ namespace replset {
 
         // Doles out all the work to the reader pool threads and waits for them to complete
         void prefetchOps(const std::deque<BSONObj>& ops);
-        // Used by the thread pool readers to prefetch an op
-        static void prefetchOp(const BSONObj& op);
 
         // Doles out all the work to the writer pool threads and waits for them to complete
         void applyOps(const std::vector< std::vector<BSONObj> >& writerVectors, 
                       MultiSyncApplyFunc applyFunc);
 
-        void fillWriterVectors(const std::deque<BSONObj>& ops, 
+        // Used by the thread pool writers to apply one writer vector and record its stats
+        static void applyWriterVector(MultiSyncApplyFunc applyFunc,
+                                      const std::vector<BSONObj>& ops,
+                                      SyncTail* st,
+                                      size_t writerId);
+
+        void fillWriterVectors(std::deque<BSONObj>::const_iterator begin,
+                               std::deque<BSONObj>::const_iterator end,
                                std::vector< std::vector<BSONObj> >* writerVectors);
         void handleSlaveDelay(const BSONObj& op);
         void setOplogVersion(const BSONObj& op);
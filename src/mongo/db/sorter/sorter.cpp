@@ -48,6 +48,7 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <boost/thread/thread.hpp>
 #include <snappy.h>
 
 #include "mongo/base/string_data.h"
@@ -56,6 +57,7 @@
 #include "mongo/db/storage_options.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/concurrency/worker_threads.h"
 #include "mongo/util/goodies.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -120,6 +122,101 @@ namespace mongo {
             const std::string _fileName;
         };
 
+        /** Either stable-sorts [begin, end) or merges the sorted ranges [begin, mid) [mid, end) */
+        template <typename Iter, typename Less>
+        class SortTask {
+        public:
+            SortTask(Iter begin, Iter end, const Less& less)
+                : _begin(begin), _mid(end), _end(end), _less(less)
+            {}
+
+            SortTask(Iter begin, Iter mid, Iter end, const Less& less)
+                : _begin(begin), _mid(mid), _end(end), _less(less)
+            {}
+
+            void operator()() {
+                try {
+                    if (_mid == _end) {
+                        std::stable_sort(_begin, _end, _less);
+                    } else {
+                        std::inplace_merge(_begin, _mid, _end, _less);
+                    }
+                } catch (const DBException& e) {
+                    error.set(e);
+                } catch (const std::exception& e) {
+                    error.set(e);
+                }
+            }
+
+            WorkerError error;
+
+        private:
+            Iter _begin;
+            Iter _mid;
+            Iter _end;
+            Less _less;
+        };
+
+        /** Runs tasks[0] on this thread and the rest on their own threads, then waits for all */
+        template <typename Task>
+        void runTasks(std::vector<Task>& tasks) {
+            boost::thread_group workers;
+            try {
+                for (size_t i = 1; i < tasks.size(); i++) {
+                    workers.create_thread(boost::ref(tasks[i]));
+                }
+            } catch (...) {
+                workers.join_all();
+                throw;
+            }
+
+            tasks[0]();
+            workers.join_all();
+
+            for (size_t i = 0; i < tasks.size(); i++) {
+                tasks[i].error.rethrowIfSet();
+            }
+        }
+
+        /**
+         * Stable-sorts [begin, end) by splitting it into one chunk per thread, sorting the chunks
+         * concurrently and then merging neighbors pairwise, also concurrently.
+         */
+        template <typename Iter, typename Less>
+        void parallelStableSort(Iter begin, Iter end, const Less& less, size_t threads) {
+            // Below this many items per thread, starting threads costs more than it saves.
+            const size_t minItemsPerThread = 1024;
+
+            const size_t numItems = end - begin;
+            threads = std::min(threads, numItems / minItemsPerThread);
+            if (threads <= 1) {
+                std::stable_sort(begin, end, less);
+                return;
+            }
+
+            typedef SortTask<Iter, Less> Task;
+
+            std::vector<Iter> bounds;
+            for (size_t i = 0; i <= threads; i++) {
+                bounds.push_back(begin + (numItems * i / threads));
+            }
+
+            std::vector<Task> sorts;
+            for (size_t i = 0; i < threads; i++) {
+                sorts.push_back(Task(bounds[i], bounds[i + 1], less));
+            }
+            runTasks(sorts);
+
+            for (size_t width = 1; width < threads; width *= 2) {
+                std::vector<Task> merges;
+                for (size_t i = 0; i + width < threads; i += 2 * width) {
+                    const size_t last = std::min(i + 2 * width, threads);
+                    merges.push_back(Task(bounds[i], bounds[i + width], bounds[last], less));
+                }
+                runTasks(merges);
+            }
+        }
+
         /** Returns results from sorted in-memory storage */
         template <typename Key, typename Value>
         class InMemIterator : public SortIteratorInterface<Key, Value> {
@@ -397,7 +494,23 @@ namespace mongo {
                 , _settings(settings)
                 , _opts(opts)
                 , _memUsed(0)
-            { verify(_opts.limit == 0); }
+                , _spillThreshold(opts.maxMemoryUsageBytes)
+            {
+                verify(_opts.limit == 0);
+
+                // With a background writer one run is being written while the next one fills,
+                // so each may only use half of the budget.
+                if (_opts.sortThreads > 1 && _opts.extSortAllowed)
+                    _spillThreshold /= 2;
+            }
+
+            ~NoLimitSorter() {
+                if (_spillThread) {
+                    DESTRUCTOR_GUARD(
+                        _spillThread->join();
+                    )
+                }
+            }
 
             void add(const Key& key, const Value& val) {
                 _data.push_back(std::make_pair(key, val));
@@ -405,22 +518,23 @@ namespace mongo {
                 _memUsed += key.memUsageForSorter();
                 _memUsed += val.memUsageForSorter();
 
-                if (_memUsed > _opts.maxMemoryUsageBytes)
+                if (_memUsed > _spillThreshold)
                     spill();
             }
 
             Iterator* done() {
-                if (_iters.empty()) {
+                if (_iters.empty() && !_spillThread) {
                     sort();
                     return new InMemIterator<Key, Value>(_data);
                 }
 
                 spill();
+                waitForSpill();
                 return Iterator::merge(_iters, _opts, _comp);
             }
 
             // TEMP these are here for compatibility. Will be replaced with a general stats API
-            int numFiles() const { return _iters.size(); }
+            int numFiles() const { return _iters.size() + (_spillThread ? 1 : 0); }
             size_t memUsed() const { return _memUsed; }
 
         private:
@@ -437,7 +551,7 @@ namespace mongo {
 
             void sort() {
                 STLComparator less(_comp);
-                std::stable_sort(_data.begin(), _data.end(), less);
+                parallelStableSort(_data.begin(), _data.end(), less, _opts.sortThreads);
 
                 // Does 2x more compares than stable_sort
                 // TODO test on windows
@@ -462,22 +576,64 @@ namespace mongo {
 
                 sort();
 
+                if (_opts.sortThreads > 1) {
+                    // Compress and write this run while the caller fills the next one.
+                    waitForSpill();
+                    _spilling.swap(_data);
+                    _spillThread.reset(new boost::thread(&NoLimitSorter::writeSpilling, this));
+                } else {
+                    _iters.push_back(boost::shared_ptr<Iterator>(writeRun(&_data)));
+                }
+
+                _memUsed = 0;
+            }
+
+            /** Writes out and empties an already sorted run */
+            Iterator* writeRun(std::deque<Data>* run) const {
                 SortedFileWriter<Key, Value> writer(_opts, _settings);
-                for ( ; !_data.empty(); _data.pop_front()) {
-                    writer.addAlreadySorted(_data.front().first, _data.front().second);
+                for ( ; !run->empty(); run->pop_front()) {
+                    writer.addAlreadySorted(run->front().first, run->front().second);
                 }
+                return writer.done();
+            }
 
-                _iters.push_back(boost::shared_ptr<Iterator>(writer.done()));
+            /** Body of _spillThread */
+            void writeSpilling() {
+                try {
+                    _spilled.reset(writeRun(&_spilling));
+                } catch (const DBException& e) {
+                    _spillError.set(e);
+                } catch (const std::exception& e) {
+                    _spillError.set(e);
+                }
+            }
 
-                _memUsed = 0;
+            void waitForSpill() {
+                if (!_spillThread)
+                    return;
+
+                _spillThread->join();
+                _spillThread.reset();
+                _spillError.rethrowIfSet();
+
+                _iters.push_back(_spilled);
+                _spilled.reset();
             }
 
             const Comparator _comp;
             const Settings _settings;
             SortOptions _opts;
             size_t _memUsed;
+            size_t _spillThreshold; // spill once _memUsed goes over this
             std::deque<Data> _data; // the "current" data
             std::vector<boost::shared_ptr<Iterator> > _iters; // data that has already been spilled
+
+            // Only used if _opts.sortThreads > 1. While _spillThread is running it owns _spilling,
+            // _spilled and _spillError.
+            boost::scoped_ptr<boost::thread> _spillThread;
+            std::deque<Data> _spilling; // sorted run being written by _spillThread
+            boost::shared_ptr<Iterator> _spilled; // iterator over what _spillThread wrote
+            WorkerError _spillError;
         };
 
         template <typename Key, typename Value, typename Comparator>
@@ -98,11 +98,15 @@ namespace mongo {
         bool extSortAllowed; /// If false, uassert if more mem needed than allowed.
         std::string tempDir; /// Directory to directly place files in.
                              /// Must be explicitly set if extSortAllowed is true.
+        size_t sortThreads; /// Threads used to sort runs and write spills. Only honored with
+                            /// no limit. If > 1 the Comparator must be safe to call from any
+                            /// thread, and Key and Value must be safe to copy and destroy there.
 
         SortOptions()
             : limit(0)
             , maxMemoryUsageBytes(64*1024*1024)
             , extSortAllowed(false)
+            , sortThreads(1)
         {}
 
         /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
@@ -126,6 +130,11 @@ namespace mongo {
             tempDir = newTempDir;
             return *this;
         }
+
+        SortOptions& SortThreads(size_t newSortThreads) {
+            sortThreads = newSortThreads;
+            return *this;
+        }
     };
 
     /// This is the output from the sorting framework
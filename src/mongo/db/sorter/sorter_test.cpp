@@ -521,6 +521,14 @@ namespace mongo {
             }
             enum { MEM_LIMIT = 32*1024 };
         };
+
+        // Sorts runs on several threads and writes spills in the background.
+        template <size_t MemLimit, bool Random=true>
+        class ParallelLotsOfData : public LotsOfDataLittleMemory<Random> {
+            SortOptions adjustSortOptions(SortOptions opts) {
+                return opts.MaxMemoryUsageBytes(MemLimit).ExtSortAllowed().SortThreads(4);
+            }
+        };
     }
 
     class SorterSuite : public mongo::unittest::Suite {
@@ -544,6 +552,9 @@ namespace mongo {
             add<SorterTests::LotsOfDataWithLimit<100,/*random=*/true> >();  // fits in mem
             add<SorterTests::LotsOfDataWithLimit<5000,/*random=*/false> >(); // spills
             add<SorterTests::LotsOfDataWithLimit<5000,/*random=*/true> >(); // spills
+            add<SorterTests::ParallelLotsOfData<256*1024,/*random=*/false> >(); // spills
+            add<SorterTests::ParallelLotsOfData<256*1024,/*random=*/true> >(); // spills
+            add<SorterTests::ParallelLotsOfData<64*1024*1024,/*random=*/true> >(); // fits in mem
         }
     } extSortTests;
 }
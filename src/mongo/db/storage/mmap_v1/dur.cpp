@@ -109,6 +109,14 @@ namespace mongo {
 
         CommitJob& commitJob = *(new CommitJob()); // don't destroy
 
+        /* set (under flushMutex) when a getlasterror j:true is waiting on the next group commit.
+           durThread waits on flushRequestedCV between commits so that it can commit right away
+           instead of at its next journalCommitInterval tick.
+        */
+        static mongo::mutex& flushMutex = *(new mongo::mutex("durFlush")); // don't destroy
+        static boost::condition flushRequestedCV;
+        static bool flushRequested = false;
+
         Stats stats;
 
         void Stats::S::reset() {
@@ -230,7 +238,15 @@ namespace mongo {
         }
 
         bool DurableImpl::awaitCommit() {
-            commitJob._notify.awaitBeyondNow();
+            // take our ticket before waking durThread, so that a commit which starts as soon as
+            // it is woken counts for us (same condition as NotifyAll::awaitBeyondNow()).
+            NotifyAll::When when = commitJob._notify.now();
+            {
+                mongo::mutex::scoped_lock lk(flushMutex);
+                flushRequested = true;
+                flushRequestedCV.notify_one();
+            }
+            commitJob._notify.waitFor(when + 1);
             return true;
         }
 
@@ -839,14 +855,18 @@ namespace mongo {
                 try {
                     stats.rotate();
 
-                    // commit sooner if one or more getLastError j:true is pending
-                    sleepmillis(oneThird);
-                    for( unsigned i = 1; i <= 2; i++ ) {
-                        if( commitJob._notify.nWaiting() )
-                            break;
-                        if( commitJob.bytes() > UncommittedBytesLimit / 2  )
-                            break;
-                        sleepmillis(oneThird);
+                    // commit right away if one or more getLastError j:true is pending. writers
+                    // which ask while we are committing get the next commit, which thus groups
+                    // all of them together.
+                    {
+                        mongo::mutex::scoped_lock lk(flushMutex);
+                        for( unsigned i = 1; i <= 3 && !flushRequested; i++ ) {
+                            if( commitJob.bytes() > UncommittedBytesLimit / 2  )
+                                break;
+                            flushRequestedCV.timed_wait(lk.boost(),
+                                                        boost::posix_time::milliseconds(oneThird));
+                        }
+                        flushRequested = false;
                     }
                                         
                     //DEV log() << "privateMapBytes=" << privateMapBytes << endl;
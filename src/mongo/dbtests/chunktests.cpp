@@ -44,6 +44,7 @@ namespace mongo {
         void setSingleChunkForShards( const vector<BSONObj> &splitPoints ) {
             ChunkMap &chunkMap = const_cast<ChunkMap&>( _chunkMap );
             ChunkRangeManager &chunkRanges = const_cast<ChunkRangeManager&>( _chunkRanges );
+            ChunkRoutingTable &chunkRouting = const_cast<ChunkRoutingTable&>( _chunkRouting );
             set<Shard> &shards = const_cast<set<Shard>&>( _shards );
             
             vector<BSONObj> mySplitPoints( splitPoints );
@@ -61,6 +62,7 @@ namespace mongo {
             }
             
             chunkRanges.reloadAll( chunkMap );
+            chunkRouting.reloadAll( chunkMap );
         }
     };
     
@@ -247,6 +249,28 @@ namespace ChunkTests {
             }
         };
 
+        /** findIntersectingChunk() routes points to the chunk whose [min, max) contains them */
+        class FindIntersectingChunk : public MultiShardBase {
+        public:
+            void run() {
+                ChunkManager chunkManager;
+                chunkManager.setShardKey( shardKey() );
+                chunkManager.setSingleChunkForShards( splitPointsVector() );
+
+                ASSERT_EQUALS( "0", shardFor( chunkManager, BSON( "a" << MINKEY ) ) );
+                ASSERT_EQUALS( "0", shardFor( chunkManager, BSON( "a" << "a" ) ) );
+                ASSERT_EQUALS( "1", shardFor( chunkManager, BSON( "a" << "x" ) ) );
+                ASSERT_EQUALS( "1", shardFor( chunkManager, BSON( "a" << "xx" ) ) );
+                ASSERT_EQUALS( "2", shardFor( chunkManager, BSON( "a" << "y" ) ) );
+                ASSERT_EQUALS( "3", shardFor( chunkManager, BSON( "a" << "z" ) ) );
+                ASSERT_EQUALS( "3", shardFor( chunkManager, BSON( "a" << "zz" ) ) );
+            }
+        private:
+            static string shardFor( const ChunkManager& chunkManager, const BSONObj& point ) {
+                return chunkManager.findIntersectingChunk( point )->getShard().getName();
+            }
+        };
+
     } // namespace ChunkManagerTests
     
     class All : public Suite {
@@ -275,6 +299,7 @@ namespace ChunkTests {
             add<ChunkManagerTests::InequalityThenUnsatisfiable>();
             add<ChunkManagerTests::OrEqualityUnsatisfiableInequality>();
             add<ChunkManagerTests::InMultiShard>();
+            add<ChunkManagerTests::FindIntersectingChunk>();
         }
     } myall;
     
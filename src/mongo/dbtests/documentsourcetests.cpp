@@ -147,6 +147,34 @@ namespace DocumentSourceTests {
                 }
             }
         };
+
+        class ExtractFields {
+        public:
+            void run() {
+                const char* array[] = {"a", "b.c"};
+                DepsTracker deps;
+                deps.fields = arrayToSet(array);
+                boost::optional<ParsedDeps> parsedDeps = deps.toParsedDeps();
+                ASSERT(parsedDeps);
+
+                // Unneeded fields before, between and after the needed ones are skipped.
+                BSONObj input = BSON("x" << 1
+                                     << "a" << 2
+                                     << "b" << BSON("c" << 3 << "d" << 4)
+                                     << "y" << 5
+                                     << "z" << 6);
+                ASSERT_EQUALS(parsedDeps->extractFields(input),
+                              DOC("a" << 2 << "b" << DOC("c" << 3)));
+
+                // Missing needed fields don't stop the scan early.
+                ASSERT_EQUALS(parsedDeps->extractFields(BSON("y" << 1 << "a" << 2)),
+                              DOC("a" << 2));
+
+                // A repeated field name only counts once toward the needed fields.
+                BSONObj repeated = BSON("a" << 1 << "a" << 2 << "b" << BSON("c" << 3));
+                ASSERT_EQUALS(parsedDeps->extractFields(repeated)["b"], Value(DOC("c" << 3)));
+            }
+        };
     }
 
     namespace DocumentSourceCursor {
@@ -1926,6 +1954,7 @@ namespace DocumentSourceTests {
         }
         void setupTests() {
             add<DocumentSourceClass::Deps>();
+            add<DocumentSourceClass::ExtractFields>();
 
             add<DocumentSourceCursor::Empty>();
             add<DocumentSourceCursor::Iterate>();
@@ -49,6 +49,7 @@
 #include "mongo/db/taskqueue.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/dbtests/framework_options.h"
+#include "mongo/s/chunk.h"
 #include "mongo/util/checksum.h"
 #include "mongo/util/compress.h"
 #include "mongo/util/concurrency/qlock.h"
@@ -483,6 +484,77 @@ namespace PerfTests {
         }
     };
 
+    /** field lookups in a document in the 5-20KB range with long, similar field names */
+    class BSONGetFieldWide : public NonDurTest {
+    public:
+        int n;
+        bo b;
+        string name() { return "BSONGetFieldWide"; }
+        BSONGetFieldWide() {
+            n = 0;
+            BSONObjBuilder bb;
+            for( int i = 0; i < 300; i++ ) {
+                stringstream ss;
+                ss << "customer_attribute_" << i;
+                bb.append( ss.str(), "some string value of moderate length" );
+            }
+            b = bb.obj();
+        }
+        void timed() {
+            if( b["customer_attribute_150"].eoo() )
+                n++;
+            if( b["customer_attribute_299"].eoo() )
+                n++;
+            if( b["customer_attribute_missing"].eoo() )
+                n++;
+        }
+    };
+
+    /**
+     * routing shard key points to one of many chunks, through the ChunkMap tree the way
+     * findIntersectingChunk used to and through the flat ChunkRoutingTable it uses now
+     */
+    class ChunkRoutingBase : public NonDurTest {
+    public:
+        int n;
+        ChunkMap chunkMap;
+        vector<BSONObj> points;
+        ChunkRoutingBase() {
+            n = 0;
+            const int nChunks = 100000;
+            Shard shard( "0", "0" );
+            BSONObj min = BSON( "a" << MINKEY );
+            for( int i = 1; i <= nChunks; i++ ) {
+                BSONObj max = i == nChunks ? BSON( "a" << MAXKEY ) : BSON( "a" << i * 10 );
+                chunkMap[max] = ChunkPtr( new Chunk( NULL, min, max, shard ) );
+                min = max;
+            }
+            for( int i = 0; i < 4096; i++ ) {
+                points.push_back( BSON( "a" << ( i * 7919 ) % ( nChunks * 10 ) ) );
+            }
+        }
+    };
+
+    class ChunkRoutingMap : public ChunkRoutingBase {
+    public:
+        string name() { return "ChunkRoutingMap"; }
+        void timed() {
+            const BSONObj& point = points[n++ % points.size()];
+            verify( chunkMap.upper_bound( point )->second->containsPoint( point ) );
+        }
+    };
+
+    class ChunkRoutingFlat : public ChunkRoutingBase {
+    public:
+        ChunkRoutingTable table;
+        ChunkRoutingFlat() { table.reloadAll( chunkMap ); }
+        string name() { return "ChunkRoutingFlat"; }
+        void timed() {
+            const BSONObj& point = points[n++ % points.size()];
+            verify( table.upperBound( point )->containsPoint( point ) );
+        }
+    };
+
     class KeyTest : public B {
     public:
         KeyV1Owned a,b,c;
@@ -1426,6 +1498,9 @@ namespace PerfTests {
                 add< BSONIter >();
                 add< BSONGetFields1 >();
                 add< BSONGetFields2 >();
+                add< BSONGetFieldWide >();
+                add< ChunkRoutingMap >();
+                add< ChunkRoutingFlat >();
                 //add< TaskQueueTest >();
                 add< InsertDup >();
                 add< Insert1 >();
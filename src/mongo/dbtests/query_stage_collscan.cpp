@@ -668,6 +668,153 @@ namespace QueryStageCollectionScan {
     };
 
 
+    //
+    // Records rejected by the filter are skipped inside a single call to work() rather than
+    // each costing a NEED_TIME round trip.
+    //
+
+    class QueryStageCollscanSkipsRejectedInWork : public QueryStageCollectionScanBase {
+    public:
+        void run() {
+            Client::ReadContext ctx(ns());
+
+            CollectionScanParams params;
+            params.collection = ctx.ctx().db()->getCollection(ns());
+            params.direction = CollectionScanParams::FORWARD;
+            params.tailable = false;
+
+            // Only the last document matches.
+            BSONObj filterObj = BSON("foo" << BSON("$gte" << numObj() - 1));
+            StatusWithMatchExpression swme = MatchExpressionParser::parse(filterObj);
+            verify(swme.isOK());
+            auto_ptr<MatchExpression> filterExpr(swme.getValue());
+
+            // Keep the in-memory check from cutting a call to work() short.
+            FailPoint* failPoint =
+                getGlobalFailPointRegistry()->getFailPoint("collscanInMemorySucceed");
+            ASSERT(NULL != failPoint);
+            failPoint->setMode(FailPoint::alwaysOn);
+
+            WorkingSet ws;
+            scoped_ptr<CollectionScan> scan(new CollectionScan(params, &ws, filterExpr.get()));
+
+            int count = 0;
+            int works = 0;
+            while (!scan->isEOF()) {
+                WorkingSetID id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = scan->work(&id);
+                ++works;
+                if (PlanStage::ADVANCED == state) {
+                    ASSERT_EQUALS(numObj() - 1, ws.get(id)->obj["foo"].numberInt());
+                    ++count;
+                }
+            }
+            failPoint->setMode(FailPoint::off);
+
+            ASSERT_EQUALS(1, count);
+
+            scoped_ptr<PlanStageStats> stats(scan->getStats());
+            const CollectionScanStats* specific =
+                static_cast<const CollectionScanStats*>(stats->specific.get());
+            ASSERT_EQUALS(static_cast<size_t>(numObj()), specific->docsTested);
+
+            // One call to initialize the iterator and one to find the match.
+            ASSERT_EQUALS(2, works);
+
+            // Plan ranking scores advanced / works, so each record tested is still charged as
+            // a work, the same as when every rejected record cost a call to work().
+            ASSERT_EQUALS(specific->docsTested + 1, stats->common.works);
+            ASSERT_EQUALS(stats->common.works, stats->common.needTime + stats->common.advanced);
+            ASSERT_EQUALS(1U, stats->common.advanced);
+        }
+    };
+
+    //
+    // Extents whose synopses rule out the filter are skipped, and writes keep the synopses
+    // correct.
+    //
+
+    class QueryStageCollscanSkipsExtents {
+    public:
+        virtual ~QueryStageCollscanSkipsExtents() {
+            Client::WriteContext ctx(ns());
+            _client.dropCollection(ns());
+        }
+
+        void run() {
+            // Documents are big enough that the collection grows several extents, and 'foo'
+            // increases with insertion order so each extent holds a distinct range of it.
+            const string pad(200, 'x');
+            for (int i = 0; i < numObj(); ++i) {
+                _client.insert(ns(), BSON("foo" << i << "pad" << pad));
+            }
+
+            BSONObj firstDoc = BSON("foo" << 0);
+
+            // The first scan reads every extent and summarizes 'foo' for each of them.
+            size_t skipped = 0;
+            size_t tested = 0;
+            ASSERT_EQUALS(1, countResults(firstDoc, &skipped, &tested));
+            ASSERT_EQUALS(0U, skipped);
+            ASSERT_EQUALS(static_cast<size_t>(numObj()), tested);
+
+            // The second only needs the first extent.
+            ASSERT_EQUALS(1, countResults(firstDoc, &skipped, &tested));
+            ASSERT_GREATER_THAN(skipped, 0U);
+            ASSERT_LESS_THAN(tested, static_cast<size_t>(numObj()));
+
+            // A new document lands in the last extent, whose range must widen to include it.
+            _client.insert(ns(), BSON("foo" << 0 << "pad" << pad));
+            ASSERT_EQUALS(2, countResults(firstDoc, &skipped, &tested));
+
+            // Same for a document changed in place.
+            _client.update(ns(),
+                           BSON("foo" << numObj() - 1),
+                           BSON("$set" << BSON("foo" << -1)));
+            ASSERT_EQUALS(1, countResults(BSON("foo" << BSON("$lt" << 0)), &skipped, &tested));
+        }
+
+    private:
+        int countResults(const BSONObj& filterObj, size_t* extentsSkipped, size_t* docsTested) {
+            Client::ReadContext ctx(ns());
+
+            CollectionScanParams params;
+            params.collection = ctx.ctx().db()->getCollection(ns());
+            params.direction = CollectionScanParams::FORWARD;
+            params.tailable = false;
+
+            StatusWithMatchExpression swme = MatchExpressionParser::parse(filterObj);
+            verify(swme.isOK());
+            auto_ptr<MatchExpression> filterExpr(swme.getValue());
+
+            WorkingSet ws;
+            scoped_ptr<CollectionScan> scan(new CollectionScan(params, &ws, filterExpr.get()));
+
+            int count = 0;
+            while (!scan->isEOF()) {
+                WorkingSetID id = WorkingSet::INVALID_ID;
+                if (PlanStage::ADVANCED == scan->work(&id)) {
+                    ++count;
+                }
+            }
+
+            scoped_ptr<PlanStageStats> stats(scan->getStats());
+            const CollectionScanStats* specific =
+                static_cast<const CollectionScanStats*>(stats->specific.get());
+            *extentsSkipped = specific->extentsSkipped;
+            *docsTested = specific->docsTested;
+            return count;
+        }
+
+        static int numObj() { return 1000; }
+
+        static const char* ns() { return "unittests.QueryStageCollectionScanSkipsExtents"; }
+
+        static DBDirectClient _client;
+    };
+
+    DBDirectClient QueryStageCollscanSkipsExtents::_client;
+
     class All : public Suite {
     public:
         All() : Suite( "QueryStageCollectionScan" ) {}
@@ -697,6 +844,8 @@ namespace QueryStageCollectionScan {
             add<QueryStageCollscanInvalidateUpcomingObject>();
             add<QueryStageCollscanInvalidateUpcomingObjectBackward>();
             add<QueryStageCollscanFetch>();
+            add<QueryStageCollscanSkipsRejectedInWork>();
+            add<QueryStageCollscanSkipsExtents>();
         }
     } all;
 
@@ -35,6 +35,7 @@
 #include "mongo/db/instance.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/dbtests/dbtests.h"
 
@@ -362,6 +363,63 @@ namespace QueryStageSortTests {
         }
     };
 
+    // With a tiny memory limit the sort hands its buffer to an external sorter and still
+    // produces the right results.
+    template <int LIMIT>
+    class QueryStageSortSpillsToDisk : public QueryStageSortTestBase {
+    public:
+        QueryStageSortSpillsToDisk()
+            : _oldMaxBytes(internalQueryExecMaxBlockingSortBytes) {
+            internalQueryExecMaxBlockingSortBytes = 2 * 1024;
+        }
+
+        virtual ~QueryStageSortSpillsToDisk() {
+            internalQueryExecMaxBlockingSortBytes = _oldMaxBytes;
+        }
+
+        virtual int numObj() { return 1000; }
+
+        virtual int limit() const { return LIMIT; }
+
+        void run() {
+            Client::WriteContext ctx(ns());
+            Database* db = ctx.ctx().db();
+            Collection* coll = db->getCollection(ns());
+            if (!coll) {
+                coll = db->createCollection(ns());
+            }
+
+            fillData();
+
+            WorkingSet* ws = new WorkingSet();
+            MockStage* ms = new MockStage(ws);
+            insertVarietyOfObjects(ms, coll);
+
+            SortStageParams params;
+            params.pattern = BSON("foo" << -1);
+            params.limit = limit();
+
+            SortStage* sort = new SortStage(params, ws, ms);
+            PlanExecutor runner(ws, new FetchStage(ws, sort, NULL, coll), coll);
+
+            int count = 0;
+            BSONObj current;
+            while (Runner::RUNNER_ADVANCED == runner.getNext(&current, NULL)) {
+                // Documents hold 0..numObj()-1, so a descending sort yields them in reverse.
+                ASSERT_EQUALS(numObj() - 1 - count, current["foo"].numberInt());
+                ++count;
+            }
+            checkCount(count);
+
+            scoped_ptr<PlanStageStats> stats(sort->getStats());
+            const SortStats* sortStats = static_cast<const SortStats*>(stats->specific.get());
+            ASSERT(sortStats->usedDisk);
+        }
+
+    private:
+        int _oldMaxBytes;
+    };
+
     class All : public Suite {
     public:
         All() : Suite( "query_stage_sort_test" ) { }
@@ -378,6 +436,8 @@ namespace QueryStageSortTests {
             add<QueryStageSortInvalidationWithLimit<10> >();
             add<QueryStageSortInvalidationWithLimit<1> >();
             add<QueryStageSortParallelArrays>();
+            add<QueryStageSortSpillsToDisk<0> >();
+            add<QueryStageSortSpillsToDisk<100> >();
         }
     }  queryStageSortTest;
 
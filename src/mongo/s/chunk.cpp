@@ -652,6 +652,7 @@ namespace mongo {
         _key( pattern ),
         _unique( unique ),
         _chunkRanges(),
+        _chunkRouting(),
         _mutex("ChunkManager"),
         _sequenceNumber(++NextSequenceNumber)
     {
@@ -671,6 +672,7 @@ namespace mongo {
                                                         BSONObj()),
         _unique(collDoc[CollectionType::unique()].trueValue()),
         _chunkRanges(),
+        _chunkRouting(),
         _mutex("ChunkManager"),
         // The shard versioning mechanism hinges on keeping track of the number of times we reloaded ChunkManager's.
         // Increasing this number here will prompt checkShardVersion() to refresh the connection-level versions to
@@ -693,6 +695,7 @@ namespace mongo {
         _key( oldManager->getShardKey() ),
         _unique( oldManager->isUnique() ),
         _chunkRanges(),
+        _chunkRouting(),
         _mutex("ChunkManager"),
         _sequenceNumber(++NextSequenceNumber)
     {
@@ -734,6 +737,7 @@ namespace mongo {
                     const_cast<set<Shard>&>(_shards).swap(shards);
                     const_cast<ShardVersionMap&>(_shardVersions).swap(shardVersions);
                     const_cast<ChunkRangeManager&>(_chunkRanges).reloadAll(_chunkMap);
+                    const_cast<ChunkRoutingTable&>(_chunkRouting).reloadAll(_chunkMap);
 
                     // Once we load data, clear reference to old manager
                     _oldManager.reset();
@@ -1108,15 +1112,7 @@ namespace mongo {
 
     ChunkPtr ChunkManager::findIntersectingChunk( const BSONObj& point ) const {
         {
-            BSONObj foo;
-            ChunkPtr c;
-            {
-                ChunkMap::const_iterator it = _chunkMap.upper_bound( point );
-                if (it != _chunkMap.end()) {
-                    foo = it->first;
-                    c = it->second;
-                }
-            }
+            ChunkPtr c = _chunkRouting.upperBound( point );
 
             if ( c ) {
                 if ( c->containsPoint( point ) ){
@@ -1124,7 +1120,6 @@ namespace mongo {
                     return c;
                 }
 
-                PRINT(foo);
                 PRINT(*c);
                 PRINT( point );
 
@@ -1446,6 +1441,34 @@ namespace mongo {
         DEV assertValid();
     }
 
+    namespace {
+        /** upper_bound comparator for ChunkRoutingTable, same ordering as ChunkMap's BSONObjCmp */
+        struct PointLessThanChunkMax {
+            bool operator()(const BSONObj& point, const pair<BSONObj,ChunkPtr>& entry) const {
+                return point.woCompare(entry.first) < 0;
+            }
+        };
+    }
+
+    void ChunkRoutingTable::reloadAll(const ChunkMap& chunks) {
+        ChunkVector flattened;
+        flattened.reserve(chunks.size());
+        for (ChunkMap::const_iterator it = chunks.begin(), end = chunks.end(); it != end; ++it) {
+            flattened.push_back(make_pair(it->first, it->second));
+        }
+        _chunks.swap(flattened);
+    }
+
+    ChunkPtr ChunkRoutingTable::upperBound(const BSONObj& point) const {
+        ChunkVector::const_iterator it = std::upper_bound(_chunks.begin(),
+                                                          _chunks.end(),
+                                                          point,
+                                                          PointLessThanChunkMax());
+        if (it == _chunks.end())
+            return ChunkPtr();
+        return it->second;
+    }
+
     void ChunkRangeManager::_insertRange(ChunkMap::const_iterator begin, const ChunkMap::const_iterator end) {
         while (begin != end) {
             ChunkMap::const_iterator first = begin;
@@ -1486,6 +1509,7 @@ namespace mongo {
     ChunkManager::ChunkManager() :
     _unique(),
     _chunkRanges(),
+    _chunkRouting(),
     _mutex( "ChunkManager" ),
     _sequenceNumber()
     {}
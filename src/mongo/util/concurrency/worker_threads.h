@@ -0,0 +1,94 @@
+/**
+*    Copyright (C) 2014 MongoDB Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <boost/thread/thread.hpp>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+    /**
+     * How many threads an operation may split its work over: 'requested' (normally a server
+     * parameter) capped at the number of cores, and never less than 1.
+     */
+    inline size_t workerThreadCount(int requested) {
+        const int cores = boost::thread::hardware_concurrency();
+        return std::max(std::min(requested, std::max(cores, 1)), 1);
+    }
+
+    /**
+     * Holds on to whatever a worker thread threw so the thread that owns it can rethrow after
+     * join().  Only the worker writes to it, and only the owner reads it after the join.  User
+     * errors (e.g. a duplicate key) are rethrown as user errors, everything else as a message
+     * assertion.
+     */
+    class WorkerError {
+    public:
+        WorkerError() : _failed(false), _userError(false), _code(0) {}
+
+        void set(const DBException& e) {
+            const AssertionException* ae = dynamic_cast<const AssertionException*>(&e);
+            _failed = true;
+            _userError = ae && ae->isUserAssertion();
+            _code = e.getCode();
+            _msg = e.what();
+        }
+
+        void set(const std::exception& e) {
+            _failed = true;
+            _userError = false;
+            _code = 0;
+            _msg = e.what();
+        }
+
+        void rethrowIfSet() const {
+            if (!_failed)
+                return;
+
+            if (_userError)
+                uasserted(_code, _msg);
+
+            msgasserted(_code ? _code : 17460,
+                        mongoutils::str::stream() << "error in worker thread: " << _msg);
+        }
+
+    private:
+        bool _failed;
+        bool _userError;
+        int _code;
+        std::string _msg;
+    };
+
+} // namespace mongo
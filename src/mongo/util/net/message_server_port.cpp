@@ -22,6 +22,8 @@
 #ifndef USE_ASIO
 
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/util/concurrency/ticketholder.h"
@@ -31,6 +33,7 @@
 #include "mongo/util/net/message_port.h"
 #include "mongo/util/net/message_server.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/timer.h"
 
 #ifdef __linux__  // TODO: consider making this ifndef _WIN32
 # include <sys/resource.h>
@@ -38,6 +41,28 @@
 
 namespace mongo {
 
+    // Number of connection threads started
+    static Counter64 threadsCreatedStats;
+    static ServerStatusMetricField<Counter64> displayThreadsCreated( "network.threads.created",
+                                                                    &threadsCreatedStats );
+
+    // Number of connection threads currently inside MessageHandler::process, as opposed to
+    // waiting for the next request from their client
+    static Counter64 threadsProcessingStats;
+    static ServerStatusMetricField<Counter64> displayThreadsProcessing(
+                                                    "network.threads.processing",
+                                                    &threadsProcessingStats );
+
+    // Number and time of hand offs from accepting a socket until its thread starts reading
+    // from it.  This takes well under a millisecond, so it is kept in micros.
+    static Counter64 dispatchNumStats;
+    static ServerStatusMetricField<Counter64> displayDispatchNum( "network.threads.dispatch.num",
+                                                                 &dispatchNumStats );
+    static Counter64 dispatchMicrosStats;
+    static ServerStatusMetricField<Counter64> displayDispatchMicros(
+                                                    "network.threads.dispatch.totalMicros",
+                                                    &dispatchMicrosStats );
+
     class PortMessageServer : public MessageServer , public Listener {
     public:
         /**
@@ -49,8 +74,17 @@ namespace mongo {
          */
         PortMessageServer(  const MessageServer::Options& opts, MessageHandler * handler ) :
             Listener( "" , opts.ipList, opts.port ), _handler(handler) {
+#ifdef __linux__
+            _initThreadAttributes();
+#endif
         }
 
+#ifdef __linux__
+        virtual ~PortMessageServer() {
+            pthread_attr_destroy(&_threadAttrs);
+        }
+#endif
+
         virtual void acceptedMP(MessagingPort * p) {
 
             if ( ! Listener::globalTicketHolder.tryAcquire() ) {
@@ -71,30 +105,12 @@ namespace mongo {
                     boost::thread thr(boost::bind(&handleIncomingMsg, himParam));
                 }
 #else
-                pthread_attr_t attrs;
-                pthread_attr_init(&attrs);
-                pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);
-
-                static const size_t STACK_SIZE = 1024*1024; // if we change this we need to update the warning
-
-                struct rlimit limits;
-                verify(getrlimit(RLIMIT_STACK, &limits) == 0);
-                if (limits.rlim_cur > STACK_SIZE) {
-                    pthread_attr_setstacksize(&attrs, (DEBUG_BUILD
-                                                        ? (STACK_SIZE / 2)
-                                                        : STACK_SIZE));
-                } else if (limits.rlim_cur < 1024*1024) {
-                    warning() << "Stack size set to " << (limits.rlim_cur/1024) << "KB. We suggest 1MB" << endl;
-                }
-
-
                 pthread_t thread;
                 HandleIncomingMsgParam* himParam = new HandleIncomingMsgParam(p, _handler);
-                int failed = pthread_create(&thread, &attrs, &handleIncomingMsg, himParam);
-
-                pthread_attr_destroy(&attrs);
+                int failed = pthread_create(&thread, &_threadAttrs, &handleIncomingMsg, himParam);
 
                 if (failed) {
+                    delete himParam;
                     log() << "pthread_create failed: " << errnoWithDescription(failed) << endl;
                     throw boost::thread_resource_error(); // for consistency with boost::thread
                 }
@@ -138,6 +154,39 @@ namespace mongo {
     private:
         MessageHandler* _handler;
 
+#ifdef __linux__
+        /**
+         * Connection threads are all created detached with the same stack size, so the
+         * attributes (and the getrlimit call behind the stack size) are set up once here
+         * instead of on every accepted connection.
+         */
+        void _initThreadAttributes() {
+            pthread_attr_init(&_threadAttrs);
+            pthread_attr_setdetachstate(&_threadAttrs, PTHREAD_CREATE_DETACHED);
+
+            static const size_t STACK_SIZE = 1024*1024; // if we change this we need to update the warning
+
+            struct rlimit limits;
+            verify(getrlimit(RLIMIT_STACK, &limits) == 0);
+            if (limits.rlim_cur > STACK_SIZE) {
+                pthread_attr_setstacksize(&_threadAttrs, (DEBUG_BUILD
+                                                           ? (STACK_SIZE / 2)
+                                                           : STACK_SIZE));
+            } else if (limits.rlim_cur < 1024*1024) {
+                warning() << "Stack size set to " << (limits.rlim_cur/1024) << "KB. We suggest 1MB" << endl;
+            }
+        }
+
+        pthread_attr_t _threadAttrs;
+#endif
+
+        /** Counts a connection thread as processing a request for the lifetime of the object */
+        class ProcessingCounter : boost::noncopyable {
+        public:
+            ProcessingCounter() { threadsProcessingStats.increment(); }
+            ~ProcessingCounter() { threadsProcessingStats.decrement(); }
+        };
+
         /**
          * Simple holder for threadRun parameters. Should not destroy the objects it holds -
          * it is the responsibility of the caller to take care of them.
@@ -149,6 +198,7 @@ namespace mongo {
 
             MessagingPort* inPort;
             MessageHandler* handler;
+            Timer sinceAccepted;
         };
 
         /**
@@ -170,6 +220,10 @@ namespace mongo {
             MessagingPort* inPort = himArg->inPort;
             MessageHandler* handler = himArg->handler;
 
+            threadsCreatedStats.increment();
+            dispatchNumStats.increment();
+            dispatchMicrosStats.increment( himArg->sinceAccepted.micros() );
+
             {
                 string threadName = "conn";
                 if ( inPort->connectionId() > 0 )
@@ -206,7 +260,10 @@ namespace mongo {
                         break;
                     }
 
-                    handler->process( m , p.get() , le );
+                    {
+                        ProcessingCounter processing;
+                        handler->process( m , p.get() , le );
+                    }
                     networkCounter.hit( p->psock->getBytesIn() , p->psock->getBytesOut() );
                 }
             }
@@ -782,6 +782,16 @@ namespace {
     }
 #endif
 
+    void yieldOrSleepFor1Microsecond() {
+#ifdef _WIN32
+        SwitchToThread();
+#elif defined(__linux__)
+        pthread_yield();
+#else
+        sleepmicros(1);
+#endif
+    }
+
     void Backoff::nextSleepMillis(){
 
         // Get the current time
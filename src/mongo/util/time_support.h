@@ -116,6 +116,9 @@ namespace mongo {
     MONGO_CLIENT_API void sleepmillis(long long ms);
     MONGO_CLIENT_API void sleepmicros(long long micros);
 
+    /** gives other threads waiting on a lock we just released a chance to take it */
+    void yieldOrSleepFor1Microsecond();
+
     class Backoff {
     public:
 